@@ -0,0 +1,200 @@
+#ifndef ALIAS_SAMPLER_HPP
+#define ALIAS_SAMPLER_HPP
+
+#include "grid_objects.hpp"
+#include "simd.hpp"
+#include <vector>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace grob{
+
+    namespace _sampler_impl{
+        /// @brief uniform double in [0,1) with 53 random bits, fast path for 64 and 32 bit engines
+        template <typename RNG>
+        inline double uniform01(RNG & rng){
+            if constexpr (RNG::min() == 0 && RNG::max() == std::numeric_limits<uint64_t>::max()){
+                return (uint64_t(rng()) >> 11)*0x1.0p-53;
+            } else if constexpr (RNG::min() == 0 && RNG::max() == std::numeric_limits<uint32_t>::max()){
+                uint64_t a = rng();
+                uint64_t b = rng();
+                return ((a << 21) | (b >> 11))*0x1.0p-53;
+            } else {
+                // generate_canonical may return 1 (LWG 2524)
+                double u = std::generate_canonical<double,53>(rng);
+                return (u < 1 ? u : std::nextafter(1.0,0.0));
+            }
+        }
+
+        /// @brief uniform point in bin: Rect coordinates are sampled, node coordinates are kept
+        template <typename RNG,typename T>
+        inline T in_bin(RNG &,T const & x){
+            return x;
+        }
+        template <typename RNG,typename T>
+        inline T in_bin(RNG & rng,Rect<T> const & R){
+            return R.left + T(uniform01(rng))*(R.right - R.left);
+        }
+        template <typename RNG,typename...Args>
+        inline auto in_bin(RNG & rng,Point<Args...> const & X){
+            // braced initialization keeps order of random draws
+            return std::apply([&](auto const &...R){
+                return Point<decltype(in_bin(rng,R))...>{in_bin(rng,R)...};
+            },X.as_tuple());
+        }
+
+        struct alias_cell{
+            double prob;
+            size_t alias;
+        };
+    };
+
+    /**
+     * \brief Walker/Vose alias table over bins of histogram (1-dim, or N-dim in linear order of values).
+     * Bin is drawn with probability proportional to its value in O(1): one table cell and one comparison,
+     * then point is uniform in bin rectangle Grid[MultiIndex].
+     * Bins of N-dim grids keep their MultiIndex, so grid rectangles are found without search
+    */
+    template <typename GridType>
+    struct alias_sampler{
+        typedef typename std::decay<GridType>::type Grid_t;
+        typedef typename Grid_t::MultiIndexType MultiIndexType;
+        constexpr static size_t Dim = Grid_t::Dim;
+
+        Grid_t Grid;
+        std::vector<_sampler_impl::alias_cell> Table;
+        std::vector<MultiIndexType> Bins;
+        double Total = 0;
+
+        alias_sampler(){}
+
+        /// @brief builds table from weights of bins in linear order, throws std::invalid_argument
+        /// if weights are negative, their sum is not positive or their number mismatches grid size
+        template <typename ContainerType>
+        alias_sampler(Grid_t _Grid,ContainerType const & Weights):Grid(std::move(_Grid)){
+            const size_t n = Grid.size();
+            if(Weights.size() != n || n == 0){
+                throw std::invalid_argument("alias_sampler: expect one weight per bin");
+            }
+            for(size_t i=0;i<n;++i){
+                if(!(Weights[i] >= 0)){
+                    throw std::invalid_argument("alias_sampler: weights should be non negative");
+                }
+                Total += Weights[i];
+            }
+            if(!(Total > 0)){
+                throw std::invalid_argument("alias_sampler: sum of weights should be positive");
+            }
+            // Vose: bins with scaled weight < 1 are filled by aliases of heavier bins
+            Table.resize(n);
+            std::vector<double> p(n);
+            std::vector<size_t> small,large;
+            for(size_t i=0;i<n;++i){
+                p[i] = Weights[i]*(n/Total);
+                (p[i] < 1 ? small : large).push_back(i);
+            }
+            while(!small.empty() && !large.empty()){
+                size_t s = small.back(),l = large.back();
+                small.pop_back();
+                Table[s] = {p[s],l};
+                p[l] -= 1 - p[s];
+                if(p[l] < 1){
+                    large.pop_back();
+                    small.push_back(l);
+                }
+            }
+            // rest have weight 1 up to rounding
+            for(size_t i : large){
+                Table[i] = {1.0,i};
+            }
+            for(size_t i : small){
+                Table[i] = {1.0,i};
+            }
+            if constexpr (Dim > 1){
+                Bins.resize(n);
+                for(auto [MI,i,X] : Grid.enumerate()){
+                    Bins[i] = MI;
+                }
+            }
+        }
+
+        inline size_t size() const noexcept{return Table.size();}
+
+        /// @brief linear index of bin
+        template <typename RNG>
+        inline size_t sample_index(RNG & rng) const{
+            double u = _sampler_impl::uniform01(rng)*Table.size();
+            // product may round up to Table.size() for u close to 1
+            size_t i = std::min(size_t(u),Table.size() - 1);
+            auto const & c = Table[i];
+            return (u - i < c.prob ? i : c.alias);
+        }
+
+        /// @brief bin rectangle (Rect for 1-dim, Point of Rect for N-dim) of linear index i
+        inline auto bin(size_t i) const noexcept{
+            if constexpr (Dim == 1){
+                return Grid[i];
+            } else {
+                return Grid[Bins[i]];
+            }
+        }
+
+        /// @return pair(linear index of bin, uniform point in bin)
+        template <typename RNG>
+        inline auto sample(RNG & rng) const{
+            size_t i = sample_index(rng);
+            return std::make_pair(i,_sampler_impl::in_bin(rng,bin(i)));
+        }
+        template <typename RNG>
+        inline auto operator()(RNG & rng) const{
+            return sample(rng);
+        }
+
+        typedef decltype(std::declval<alias_sampler const &>().sample(std::declval<std::mt19937_64 &>())) sample_type;
+
+        /**
+         * \brief fills out[0..n) with samples. Bins of a chunk are drawn first and their
+         * table cells and rectangles are prefetched, then points are drawn
+        */
+        template <typename RNG,typename Sample_t>
+        void sample_n(RNG & rng,Sample_t * out,size_t n) const{
+            constexpr size_t chunk = 256;
+            double u[chunk];
+            size_t idx[chunk];
+            for(size_t k=0;k<n;k += chunk){
+                size_t m = (n - k < chunk ? n - k : chunk);
+                for(size_t l=0;l<m;++l){
+                    u[l] = _sampler_impl::uniform01(rng)*Table.size();
+                    idx[l] = std::min(size_t(u[l]),Table.size() - 1);
+                    GROB_PREFETCH(Table.data() + idx[l]);
+                }
+                for(size_t l=0;l<m;++l){
+                    auto const & c = Table[idx[l]];
+                    idx[l] = (u[l] - idx[l] < c.prob ? idx[l] : c.alias);
+                    if constexpr (Dim > 1){
+                        GROB_PREFETCH(Bins.data() + idx[l]);
+                    }
+                }
+                for(size_t l=0;l<m;++l){
+                    out[k+l] = Sample_t(idx[l],_sampler_impl::in_bin(rng,bin(idx[l])));
+                }
+            }
+        }
+        /// @brief fills all elements of container out (e.g. std::vector<sample_type>)
+        template <typename RNG,typename ContainerType>
+        inline void sample_n(RNG & rng,ContainerType & out) const{
+            sample_n(rng,out.data(),out.size());
+        }
+    };
+
+    /// @brief alias sampler of bins of Histogramm, proportional to its values
+    template <typename GridType,typename ContainerType,typename ValueSetter>
+    auto make_alias_sampler(Histogramm<GridType,ContainerType,ValueSetter> const & H){
+        return alias_sampler<typename std::decay<GridType>::type>(H.Grid,H.Values);
+    }
+};
+
+#endif//ALIAS_SAMPLER_HPP
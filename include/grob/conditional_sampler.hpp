@@ -0,0 +1,180 @@
+#ifndef CONDITIONAL_SAMPLER_HPP
+#define CONDITIONAL_SAMPLER_HPP
+
+#include "alias_sampler.hpp"
+#include <array>
+#include <cmath>
+
+namespace grob{
+
+    namespace _sampler_impl{
+        /// @brief 1-dim grid of nodes of level: grid itself for 1-dim grids, grid() for multidim
+        template <typename GridType>
+        inline auto const & axis(GridType const & grid) noexcept{
+            if constexpr (GridType::Dim == 1){
+                return grid;
+            } else {
+                return grid.grid();
+            }
+        }
+
+        /**
+         * \brief solves h*(a*t + (b-a)*t^2/2) = r for t in [0,1]:
+         * inverse of cumulative integral of linear density from a to b on cell of width h
+        */
+        template <typename V,typename X>
+        inline V linear_cell_inverse(V a,V b,X h,V r) noexcept{
+            V s = r/h;
+            V d = a + std::sqrt(std::max(V(0),a*a + 2*(b - a)*s));
+            V t = (d > 0 ? 2*s/d : V(0));
+            return std::clamp(t,V(0),V(1));
+        }
+
+        template <size_t d,typename T,typename X>
+        inline void set_coord(T & P,X const & x) noexcept{
+            if constexpr (std::is_arithmetic<T>::value){
+                P = x;
+            } else {
+                std::get<d>(P.as_tuple()) = x;
+            }
+        }
+    };
+
+    /**
+     * \brief samples points from N-dim density, given as multilinear interpolation (linear_interpolator)
+     * over Grid1, MultiGrid (regular or ragged) or RectilinearGrid, without rejection.
+     * Level d keeps nodes of all 1-dim rows of coordinate d in linear (lexicographic) order:
+     * Mass[d] is integral of density over coordinates after d at node, Cum[d] is cumulative integral along row,
+     * Child[d] is position of first node of inner row in level d+1. Nodes of last level are linear indexes of grid.
+     * Sampling descends levels: row cell is found by binary search in Cum, coordinate by inverse of linear density
+     * in cell, and inner row is one of two nodes of cell with probability of their weights at this coordinate,
+     * so one point costs Dim searches and 2*Dim - 1 random numbers.
+     * Between rows of ragged grid density is mixture of rows, each row density vanishes out of its nodes range
+     * (the same as interpolation, if neighbour rows have the same range)
+    */
+    template <typename GridType,typename V>
+    struct conditional_sampler{
+        typedef typename std::decay<GridType>::type Grid_t;
+        typedef typename Grid_t::value_type value_type;
+        constexpr static size_t Dim = Grid_t::Dim;
+
+        Grid_t Grid;
+        std::array<std::vector<V>,Dim> Mass;
+        std::array<std::vector<V>,Dim> Cum;
+        std::array<std::vector<size_t>,Dim-1> Child;
+
+        conditional_sampler(){}
+
+        /// @brief builds tables from density values in linear order of grid, throws std::invalid_argument
+        /// if values are negative, integral of density is not positive or their number mismatches grid size
+        template <typename ContainerType>
+        conditional_sampler(Grid_t _Grid,ContainerType const & Values):Grid(std::move(_Grid)){
+            const size_t n = Grid.size();
+            if(Values.size() != n){
+                throw std::invalid_argument("conditional_sampler: expect one value per grid node");
+            }
+            Mass[Dim-1].resize(n);
+            for(size_t i=0;i<n;++i){
+                if(!(Values[i] >= 0)){
+                    throw std::invalid_argument("conditional_sampler: density should be non negative");
+                }
+                Mass[Dim-1][i] = Values[i];
+            }
+            size_t leaf = 0;
+            if(!(build<0>(Grid,leaf) > 0)){
+                throw std::invalid_argument("conditional_sampler: integral of density should be positive");
+            }
+        }
+
+        /// @brief integral of density over grid
+        inline V total() const noexcept{return Cum[0].back();}
+
+        /// @return random point
+        template <typename RNG>
+        inline value_type sample(RNG & rng) const{
+            value_type P;
+            descend<0>(Grid,0,rng,P);
+            return P;
+        }
+        template <typename RNG>
+        inline value_type operator()(RNG & rng) const{
+            return sample(rng);
+        }
+
+        /// @brief fills all elements of container out (e.g. std::vector<value_type>)
+        template <typename RNG,typename ContainerType>
+        inline void sample_n(RNG & rng,ContainerType & out) const{
+            for(auto & P : out){
+                P = sample(rng);
+            }
+        }
+
+        private:
+        /// @brief appends row of level d (nodes of axis(grid)), leaf is next linear index of last level
+        /// @return integral of density over row
+        template <size_t d,typename LevelGrid>
+        V build(LevelGrid const & grid,size_t & leaf){
+            auto const & A = _sampler_impl::axis(grid);
+            const size_t m = A.size();
+            size_t start;
+            if constexpr (d + 1 == Dim){
+                start = leaf;
+                leaf += m;
+            } else {
+                start = Mass[d].size();
+                Mass[d].resize(start + m);
+                Child[d].resize(start + m);
+                for(size_t k=0;k<m;++k){
+                    Child[d][start + k] = (d + 2 == Dim ? leaf : Mass[d+1].size());
+                    Mass[d][start + k] = build<d+1>(grid.inner(k),leaf);
+                }
+            }
+            Cum[d].resize(start + m);
+            V sum = 0;
+            Cum[d][start] = 0;
+            for(size_t k=1;k<m;++k){
+                sum += (A[k] - A[k-1])*(Mass[d][start + k - 1] + Mass[d][start + k])/2;
+                Cum[d][start + k] = sum;
+            }
+            return sum;
+        }
+
+        template <size_t d,typename LevelGrid,typename RNG>
+        void descend(LevelGrid const & grid,size_t start,RNG & rng,value_type & P) const{
+            auto const & A = _sampler_impl::axis(grid);
+            const size_t m = A.size();
+            const V * cum = Cum[d].data() + start;
+            const V * mass = Mass[d].data() + start;
+            V u = V(_sampler_impl::uniform01(rng))*cum[m-1];
+            size_t k = (m < 2 ? 0 : std::upper_bound(cum + 1,cum + m - 1,u) - cum - 1);
+            V t = 0;
+            if(m > 1){
+                t = _sampler_impl::linear_cell_inverse(mass[k],mass[k+1],A[k+1] - A[k],u - cum[k]);
+                _sampler_impl::set_coord<d>(P,A[k] + t*(A[k+1] - A[k]));
+            } else {
+                _sampler_impl::set_coord<d>(P,A[0]);
+            }
+            if constexpr (d + 1 < Dim){
+                size_t j = k;
+                if(m > 1){
+                    V wa = (1 - t)*mass[k],wb = t*mass[k+1];
+                    bool right = (wa + wb > 0 ? V(_sampler_impl::uniform01(rng))*(wa + wb) >= wa : mass[k+1] > mass[k]);
+                    j += right;
+                }
+                descend<d+1>(grid.inner(j),Child[d][start + j],rng,P);
+            }
+        }
+    };
+
+    /// @brief sampler of points with density F (linear interpolation, values are non negative)
+    template <typename Interpolator,typename GridType,typename ContainerType>
+    auto make_conditional_sampler(GridFunction<Interpolator,GridType,ContainerType> const & F){
+        static_assert(std::is_same<Interpolator,linear_interpolator>::value ||
+                      std::is_same<Interpolator,multilinear_interpolator>::value,
+                      "conditional sampler expects linear interpolation of density");
+        typedef typename std::decay<decltype(F.Values[0])>::type V;
+        return conditional_sampler<typename std::decay<GridType>::type,V>(F.Grid,F.Values);
+    }
+};
+
+#endif//CONDITIONAL_SAMPLER_HPP
@@ -208,6 +208,42 @@ namespace grob{
         }
     };
 
+    /// @brief offsets of ragged rows: i*len_ if all rows have the same length len_,
+    /// explicit offsets otherwise
+    struct HybridIndexer{
+        size_t size_;
+        size_t len_;
+        std::vector<size_t> offsets_;
+
+        typedef size_t value_type;
+        HybridIndexer(size_t size_ = 0,size_t len_ = 1):size_(size_),len_(len_){}
+        HybridIndexer(std::vector<size_t> offsets_):size_(offsets_.size()),len_(0),offsets_(std::move(offsets_)){}
+
+        size_t inline constexpr  operator [](size_t i)const noexcept{return len_ ? i*len_ : offsets_[i];}
+        size_t inline constexpr  size()const noexcept{return size_;}
+
+        inline constexpr size_t first()const noexcept{return 0;}
+        inline constexpr size_t back()const noexcept{return (*this)[size_-1];}
+        inline constexpr bool is_linear()const noexcept{return len_ != 0;}
+    };
+
+    /// @brief offsets[i] - i*shift_ over not owned sorted offsets
+    struct OffsetsViewIndexer{
+        const size_t * offsets_;
+        size_t size_;
+        size_t shift_;
+
+        typedef size_t value_type;
+        OffsetsViewIndexer(const size_t * offsets_ = nullptr,size_t size_ = 0,size_t shift_ = 0):
+            offsets_(offsets_),size_(size_),shift_(shift_){}
+
+        size_t inline constexpr  operator [](size_t i)const noexcept{return offsets_[i] - i*shift_;}
+        size_t inline constexpr  size()const noexcept{return size_;}
+
+        inline constexpr size_t first()const noexcept{return 0;}
+        inline constexpr size_t back()const noexcept{return (*this)[size_-1];}
+    };
+
     template <typename Container>
     struct is_const_container{
         constexpr static bool value = false;
@@ -254,6 +290,10 @@ namespace grob{
             return cnt.find(i);
         }
 
+        inline size_t find_index(HybridIndexer const& cnt,size_t i){
+            return cnt.len_ ? i/cnt.len_ : __find_int_index_sorted_with_guess(cnt.offsets_,i);
+        }
+
         template <typename ContainerOfContainer,typename Iterator>
         inline void _init_index_count(const ContainerOfContainer & _CC,Iterator it) noexcept{
             *it = 0;
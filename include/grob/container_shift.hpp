@@ -2,6 +2,8 @@
 #define CONTAINER_SHIFT_HPP
 #include <vector>
 #include <array>
+#include <iostream>
+#include <sstream>
 
 namespace grob{
 
@@ -18,6 +20,12 @@ struct vector_view{
     
     inline operator T * ()noexcept{return values;}
     inline operator const T * () const noexcept{return values;}
+
+    inline constexpr T & operator[](size_t i) noexcept{return values[i];}
+    inline constexpr const T & operator[](size_t i) const noexcept{return values[i];}
+    inline constexpr const T & front() const noexcept{return values[0];}
+    inline constexpr const T & back() const noexcept{return values[_size-1];}
+    inline constexpr const T * data() const noexcept{return values;}
     
     typedef T * iterator;
     typedef const T * const_iterator;
@@ -27,6 +35,21 @@ struct vector_view{
     inline const T *  cend()const noexcept{return values+_size;}
     inline const T *  begin()const noexcept{return cbegin();}
     inline const T *  end()const noexcept{return cend();}
+
+    friend std::ostream & operator << (std::ostream & os,vector_view const & V){
+        std::ostringstream S;
+        S << "View[";
+        for(size_t i=0;i<V._size;++i){
+            if(i){
+                S <<", " << V.values[i];
+            }
+            else{
+                S << V.values[i];
+            }
+        }
+        S << "]";
+        return os << S.str();
+    }
 };
 
 template <typename Container>
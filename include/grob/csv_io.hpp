@@ -79,11 +79,9 @@ struct csv_viewer{
     }
     template <typename stream_type,typename OutMethod =decltype(std::scientific)>
     void save(stream_type && os,size_t precision = 6,OutMethod M = std::scientific)const{
-        size_t i=0;
-
-        for(auto MI = Object.Grid.Multi0();MI != Object.Grid.MultiSize();Object.Grid.MultiIncrement(MI),++i){
-            detail::tp_to_csv<GOType::Dim>::write(os,Object.Grid[MI],'\t');
-            os << std::setprecision(precision) <<M <<  Object.Values[Object.Grid.LinearIndex(MI)]<< std::endl;
+        for(auto [MI,i,X,V] : Object.enumerate()){
+            detail::tp_to_csv<GOType::Dim>::write(os,X,'\t');
+            os << std::setprecision(precision) <<M << V << std::endl;
         }
     }
 };
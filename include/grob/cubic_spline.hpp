@@ -0,0 +1,359 @@
+#ifndef CUBIC_SPLINE_HPP
+#define CUBIC_SPLINE_HPP
+
+#include "grid_objects.hpp"
+#include <vector>
+#include <stdexcept>
+
+namespace grob{
+
+    /**
+     * \brief kind of cubic spline, precomputed in spline_values
+     * hermite: derivatives by finite differences, the same as interpolator_spline1D (C1)
+     * natural: C2 spline with zero second derivatives at ends
+     * clamped: C2 spline with given first derivatives at ends
+     * pchip: monotone piecewise cubic (Fritsch-Carlson), weighted harmonic mean of secants
+     * steffen: monotone spline of M. Steffen (1990), no overshoot in any cell
+     * akima: Akima (1970) slopes, local and without wiggles near outliers
+    */
+    enum class spline_kind{hermite,natural,clamped,pchip,steffen,akima};
+
+    namespace _spline_impl{
+        /// @brief coefficients of cell polynomial c0 + c1*u + c2*u^2 + c3*u^3, u in [0,1],
+        /// from values v0,v1 and derivatives d0,d1 by u
+        template <typename V>
+        inline void hermite_cell(V * c,V const & v0,V const & v1,V const & d0,V const & d1) noexcept{
+            c[0] = v0;
+            c[1] = d0;
+            c[2] = 3*(v1 - v0) - 2*d0 - d1;
+            c[3] = 2*(v0 - v1) + d0 + d1;
+        }
+
+        /// @brief coefficients of interpolator_spline1D: finite difference derivatives,
+        /// quadratic first and last cells
+        template <typename GridType,typename V>
+        void hermite_coeffs(GridType const & grid,std::vector<V> const & values,std::vector<V> & Coeffs){
+            const size_t n = values.size();
+            if(n == 2){
+                Coeffs = {values[0],values[1] - values[0],V(0),V(0)};
+                return;
+            }
+            // derivative at inner node i by x
+            auto Derivative = [&](size_t i){
+                auto h1 = grid[i] - grid[i-1];
+                auto h2 = grid[i+1] - grid[i];
+                auto q = 1/(h1*h2*(h1+h2));
+                auto a1 = h2*h2*q;
+                auto a2 = h1*h1*q;
+                return -a1*values[i-1]+a2*values[i+1] + (a1-a2)*values[i];
+            };
+            for(size_t i=0;i+1<n;++i){
+                V * c = Coeffs.data() + 4*i;
+                auto h = grid[i+1] - grid[i];
+                if(i == 0){
+                    V D = h*Derivative(1);
+                    c[0] = values[0];
+                    c[1] = 2*(values[1] - values[0]) - D;
+                    c[2] = D + values[0] - values[1];
+                    c[3] = 0;
+                } else if(i == n-2){
+                    V D = h*Derivative(i);
+                    c[0] = values[i];
+                    c[1] = D;
+                    c[2] = values[i+1] - values[i] - D;
+                    c[3] = 0;
+                } else {
+                    hermite_cell(c,values[i],values[i+1],V(h*Derivative(i)),V(h*Derivative(i+1)));
+                }
+            }
+        }
+
+        /// @brief C2 spline: second derivatives M are found from tridiagonal system (Thomas algorithm)
+        template <typename GridType,typename V>
+        void c2_coeffs(GridType const & grid,std::vector<V> const & values,std::vector<V> & Coeffs,
+                        spline_kind kind,V const & d_left,V const & d_right){
+            const size_t n = values.size();
+            typedef typename std::decay<decltype(grid[0])>::type X;
+            std::vector<X> h(n-1);
+            for(size_t i=0;i+1<n;++i){
+                h[i] = grid[i+1] - grid[i];
+            }
+            auto slope = [&](size_t i){return (values[i+1] - values[i])/h[i];};
+            // row i: a[i]*M[i-1] + b[i]*M[i] + c[i]*M[i+1] = r[i]
+            std::vector<X> a(n,0),b(n,1),c(n,0);
+            std::vector<V> r(n,V(0));
+            for(size_t i=1;i+1<n;++i){
+                a[i] = h[i-1];
+                b[i] = 2*(h[i-1] + h[i]);
+                c[i] = h[i];
+                r[i] = 6*(slope(i) - slope(i-1));
+            }
+            if(kind == spline_kind::clamped){
+                b[0] = 2*h[0];
+                c[0] = h[0];
+                r[0] = 6*(slope(0) - d_left);
+                a[n-1] = h[n-2];
+                b[n-1] = 2*h[n-2];
+                r[n-1] = 6*(d_right - slope(n-2));
+            }
+            for(size_t i=1;i<n;++i){
+                X w = a[i]/b[i-1];
+                b[i] -= w*c[i-1];
+                r[i] -= w*r[i-1];
+            }
+            std::vector<V> M(n);
+            M[n-1] = r[n-1]/b[n-1];
+            for(size_t i=n-1;i-- > 0;){
+                M[i] = (r[i] - c[i]*M[i+1])/b[i];
+            }
+            for(size_t i=0;i+1<n;++i){
+                V * C = Coeffs.data() + 4*i;
+                auto hq = h[i]*h[i];
+                C[0] = values[i];
+                C[1] = values[i+1] - values[i] - hq*(2*M[i] + M[i+1])/6;
+                C[2] = hq*M[i]/2;
+                C[3] = hq*(M[i+1] - M[i])/6;
+            }
+        }
+    };
+
+    namespace _spline_impl{
+        template <typename T>
+        inline T sign(T const & x) noexcept{
+            return T((T(0) < x) - (x < T(0)));
+        }
+
+        /// @brief shape preserving slopes (by x) at nodes, grid size >= 3
+        template <typename GridType,typename V>
+        std::vector<V> shape_slopes(GridType const & grid,std::vector<V> const & values,spline_kind kind){
+            using std::abs;
+            const size_t n = values.size();
+            typedef typename std::decay<decltype(grid[0])>::type X;
+            std::vector<X> h(n-1);
+            std::vector<V> m(n-1);
+            for(size_t i=0;i+1<n;++i){
+                h[i] = grid[i+1] - grid[i];
+                m[i] = (values[i+1] - values[i])/h[i];
+            }
+            std::vector<V> d(n);
+            if(kind == spline_kind::pchip){
+                for(size_t i=1;i+1<n;++i){
+                    if(m[i-1]*m[i] <= 0){
+                        d[i] = 0;
+                    } else {
+                        auto w1 = 2*h[i] + h[i-1];
+                        auto w2 = h[i] + 2*h[i-1];
+                        d[i] = (w1 + w2)/(w1/m[i-1] + w2/m[i]);
+                    }
+                }
+                // one-sided three point estimate, limited to keep monotonicity
+                auto edge = [](X h0,X h1,V m0,V m1){
+                    V d = ((2*h0 + h1)*m0 - h0*m1)/(h0 + h1);
+                    if(sign(d) != sign(m0))
+                        return V(0);
+                    if(sign(m0) != sign(m1) && abs(d) > abs(3*m0))
+                        return V(3*m0);
+                    return d;
+                };
+                d[0] = edge(h[0],h[1],m[0],m[1]);
+                d[n-1] = edge(h[n-2],h[n-3],m[n-2],m[n-3]);
+            } else if(kind == spline_kind::steffen){
+                for(size_t i=1;i+1<n;++i){
+                    V p = (m[i-1]*h[i] + m[i]*h[i-1])/(h[i-1] + h[i]);
+                    d[i] = (sign(m[i-1]) + sign(m[i]))*std::min({abs(m[i-1]),abs(m[i]),abs(p)/2});
+                }
+                auto edge = [](X h0,X h1,V m0,V m1){
+                    V p = m0*(1 + h0/(h0 + h1)) - m1*h0/(h0 + h1);
+                    if(p*m0 <= 0)
+                        return V(0);
+                    if(abs(p) > abs(2*m0))
+                        return V(2*m0);
+                    return p;
+                };
+                d[0] = edge(h[0],h[1],m[0],m[1]);
+                d[n-1] = edge(h[n-2],h[n-3],m[n-2],m[n-3]);
+            } else {
+                // secants with 2 extrapolated on each side: M[k+2] = m[k]
+                std::vector<V> M(n+3);
+                std::copy(m.begin(),m.end(),M.begin() + 2);
+                M[1] = 2*M[2] - M[3];
+                M[0] = 2*M[1] - M[2];
+                M[n+1] = 2*M[n] - M[n-1];
+                M[n+2] = 2*M[n+1] - M[n];
+                for(size_t i=0;i<n;++i){
+                    auto w1 = abs(M[i+3] - M[i+2]);
+                    auto w2 = abs(M[i+1] - M[i]);
+                    d[i] = (w1 + w2 == 0 ? (M[i+1] + M[i+2])/2 : (w1*M[i+1] + w2*M[i+2])/(w1 + w2));
+                }
+            }
+            return d;
+        }
+
+        /// @brief Hermite cells with slopes d by x
+        template <typename GridType,typename V>
+        void slope_coeffs(GridType const & grid,std::vector<V> const & values,std::vector<V> const & d,
+                            std::vector<V> & Coeffs){
+            for(size_t i=0;i+1<values.size();++i){
+                auto h = grid[i+1] - grid[i];
+                hermite_cell(Coeffs.data() + 4*i,values[i],values[i+1],V(h*d[i]),V(h*d[i+1]));
+            }
+        }
+    };
+
+    /**
+     * \brief values of 1-dim grid function with precomputed cubic polynomial of each cell:
+     * Coeffs[4*i + k] is coefficient of u^k in cell i, u = (x-grid[i])/(grid[i+1]-grid[i]).
+     * Values are immutable, coefficients are computed in constructor
+    */
+    template <typename V>
+    struct spline_values{
+        typedef V value_type;
+        std::vector<V> Values;
+        std::vector<V> Coeffs;
+
+        inline spline_values(){}
+        inline spline_values(std::vector<V> Values,std::vector<V> Coeffs):
+            Values(std::move(Values)),Coeffs(std::move(Coeffs)){}
+
+        /// @param d_left,d_right derivatives at ends for spline_kind::clamped
+        template <typename GridType>
+        spline_values(GridType const & grid,std::vector<V> values,spline_kind kind = spline_kind::hermite,
+                        V const & d_left = V(0),V const & d_right = V(0)):Values(std::move(values)){
+            static_assert(std::decay<GridType>::type::Dim == 1,"spline_values are defined for 1-dim grids");
+            if(Values.size() != grid.size() || grid.size() < 2){
+                throw std::invalid_argument("spline_values: expect grid size >= 2 and the same number of values");
+            }
+            Coeffs.resize(4*(Values.size() - 1));
+            if(kind == spline_kind::hermite){
+                _spline_impl::hermite_coeffs(grid,Values,Coeffs);
+            } else if(kind == spline_kind::natural || kind == spline_kind::clamped){
+                _spline_impl::c2_coeffs(grid,Values,Coeffs,kind,d_left,d_right);
+            } else if(Values.size() == 2){
+                Coeffs = {Values[0],Values[1] - Values[0],V(0),V(0)};
+            } else {
+                _spline_impl::slope_coeffs(grid,Values,_spline_impl::shape_slopes(grid,Values,kind),Coeffs);
+            }
+        }
+
+        inline size_t size() const noexcept{return Values.size();}
+        inline V const & operator[](size_t i) const noexcept{return Values[i];}
+        /// @brief pointer to 4 coefficients of cell i
+        inline const V * cell(size_t i) const noexcept{return Coeffs.data() + 4*i;}
+
+        friend std::ostream & operator << (std::ostream & os,spline_values const & SV){
+            std::ostringstream S;
+            S << "spline_values[";
+            for(size_t i=0;i<SV.size();++i){
+                if(i)
+                    S << ", ";
+                S << SV[i];
+            }
+            S << "]";
+            return os << S.str();
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("Values","Coeffs"),
+                              PROPERTIES(Values,Coeffs))
+        WRITE_FUNCTION(Values,Coeffs)
+        DESERIALIZATOR_FUNCTION(spline_values,
+            PROPERTY_NAMES("Values","Coeffs"),
+            PROPERTY_TYPES(Values,Coeffs))
+        READ_FUNCTION(spline_values,PROPERTY_TYPES(Values,Coeffs))
+    };
+
+    /// @brief cubic spline over spline_values: one locate and Horner evaluation of cell polynomial,
+    /// outside of grid polynomial of boundary cell is extrapolated
+    struct interpolator_cubic_spline{
+        template <typename GridType,typename V,typename Point_t>
+        inline static auto interpolate(GridType const & grid,
+                                    spline_values<V> const & values,
+                                    Point_t const & point) noexcept{
+            size_t i;
+            auto u = _multilinear_impl::cell(grid,point,i);
+            const V * c = values.cell(i);
+            return c[0] + u*(c[1] + u*(c[2] + u*c[3]));
+        }
+
+        /// @brief out[k] = interpolate(grid,values,xs[k]), cells are located by grid.pos_batch
+        template <typename GridType,typename V,typename T,typename R>
+        inline static void interpolate_batch(GridType const & grid,spline_values<V> const & values,
+                                            const T * xs,size_t n,R * out) noexcept{
+            typedef typename std::decay<decltype(grid[0])>::type W;
+            constexpr size_t chunk = _eval_batch_impl::chunk;
+            size_t idx[chunk];
+            W u[chunk];
+            for(size_t k=0;k<n;k += chunk){
+                size_t m = (n - k < chunk ? n - k : chunk);
+                grid.pos_batch(xs + k,m,idx);
+                for(size_t l=0;l<m;++l){
+                    GROB_PREFETCH(values.cell(idx[l]));
+                }
+                _eval_batch_impl::cell_weights(grid,xs + k,idx,m,u);
+                for(size_t l=0;l<m;++l){
+                    const V * c = values.cell(idx[l]);
+                    out[k+l] = c[0] + u[l]*(c[1] + u[l]*(c[2] + u[l]*c[3]));
+                }
+            }
+        }
+    };
+
+    /// @brief cubic spline over spline_values, evaluating pair(value, derivative)
+    struct interpolator_cubic_spline_diff{
+        template <typename GridType,typename V,typename Point_t>
+        inline static auto interpolate(GridType const & grid,
+                                    spline_values<V> const & values,
+                                    Point_t const & point) noexcept{
+            size_t i = grid.pos(point);
+            auto h_inv = 1/(grid[i+1] - grid[i]);
+            auto u = (point - grid[i])*h_inv;
+            const V * c = values.cell(i);
+            return std::pair<V,V>(c[0] + u*(c[1] + u*(c[2] + u*c[3])),
+                                (c[1] + u*(2*c[2] + 3*u*c[3]))*h_inv);
+        }
+    };
+
+    namespace _spline_impl{
+        template <typename Interpolator>
+        struct is_hidden_interpolator : std::false_type{};
+        template <typename Interpolator>
+        struct is_hidden_interpolator<interpolator_functional_grid<Interpolator>> : std::true_type{};
+
+        /// @brief grid, in which coordinates polynomials are built:
+        /// hidden uniform grid for interpolHidden over functional grid, and grid itself otherwise
+        template <typename Interpolator,typename GridType>
+        inline decltype(auto) coefficient_grid(GridType const & grid) noexcept{
+            using namespace __detail_uniform;
+            if constexpr (is_hidden_interpolator<Interpolator>::value &&
+                        decltype(is_functional_grid(self_t<GridType>{}))::value){
+                return static_cast<const GridUniform<typename GridType::hidden_value_type> &>(grid.hidden());
+            } else {
+                return grid;
+            }
+        }
+    };
+
+    /// @brief makes 1-dim cubic spline GridFunction with precomputed cell polynomials.
+    /// For interpolHidden<interpolator_cubic_spline> over functional grid polynomials are built in hidden coordinate
+    /// @param d_left,d_right derivatives at ends for spline_kind::clamped
+    template <typename Interpolator = interpolator_cubic_spline,typename GridType,typename V>
+    auto make_spline_function(GridType && Grid,std::vector<V> Values,spline_kind kind = spline_kind::hermite,
+                            V const & d_left = V(0),V const & d_right = V(0)){
+        spline_values<V> SV(_spline_impl::coefficient_grid<Interpolator>(Grid),std::move(Values),kind,d_left,d_right);
+        return GridFunction<Interpolator,typename std::decay<GridType>::type,spline_values<V>>(
+                std::forward<GridType>(Grid),std::move(SV));
+    }
+
+    /// @brief the same as make_spline_function, values are Func(x) at grid nodes
+    template <typename Interpolator = interpolator_cubic_spline,typename GridType,typename LambdaType,
+                typename V = typename std::decay<decltype(std::declval<LambdaType>()(std::declval<GridType>()[0]))>::type>
+    auto make_spline_function_f(GridType && Grid,LambdaType && Func,spline_kind kind = spline_kind::hermite,
+                            V const & d_left = V(0),V const & d_right = V(0)){
+        std::vector<V> Values(Grid.size());
+        for(size_t i=0;i<Grid.size();++i){
+            Values[i] = Func(Grid[i]);
+        }
+        return make_spline_function<Interpolator>(std::forward<GridType>(Grid),std::move(Values),kind,d_left,d_right);
+    }
+};
+
+#endif//CUBIC_SPLINE_HPP
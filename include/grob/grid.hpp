@@ -5,12 +5,17 @@
 #include <array>
 #include <sstream>
 #include <algorithm>
+#include <optional>
+#include <ratio>
+#include <stdexcept>
 #include "rectangle.hpp"
 #include "serialization.hpp"
 #include "templates.hpp"
 #include "container_shift.hpp"
 #include "iterator_template.hpp"
 #include "object_serialization.hpp"
+#include "simd.hpp"
+#include "transforms.hpp"
 
 /*!
     \brief implementation and definition of grid
@@ -55,20 +60,119 @@ namespace grob{
     };
     */
    
+    namespace _batch_impl{
+        struct not_batchable{};
+
+        template <typename Helper,typename cnt_type,typename T>
+        auto pos_batch_check(Helper *,cnt_type const & Grd,T const * xs)
+            ->decltype(Helper::pos_batch_impl(Grd,xs,0,(size_t *)nullptr));
+        not_batchable pos_batch_check(...);
+
+        /// @brief checks if Helper has static pos_batch_impl(Grd,xs,n,out)
+        template <typename Helper,typename cnt_type,typename T>
+        struct has_pos_batch: templdefs::is_not_same<not_batchable,
+                    decltype(
+                        pos_batch_check(std::declval<Helper *>(),std::declval<cnt_type const &>(),std::declval<T const *>())
+                    )>{};
+
+        template <bool _has_batch>
+        struct _condition_pos_batch{
+            template <typename Helper,typename cnt_type,typename T>
+            static inline void function(cnt_type const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+                for(size_t i=0;i<n;++i){
+                    out[i] = Helper::pos_impl(Grd,xs[i]);
+                }
+            }
+        };
+        template <>
+        struct _condition_pos_batch<true>{
+            template <typename Helper,typename cnt_type,typename T>
+            static inline void function(cnt_type const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+                Helper::pos_batch_impl(Grd,xs,n,out);
+            }
+        };
+
+        /// @brief calls Helper::pos_batch_impl if exists, otherwise loops over Helper::pos_impl
+        template <typename Helper,typename cnt_type,typename T>
+        inline void pos_batch(cnt_type const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+            _condition_pos_batch<has_pos_batch<Helper,cnt_type,T>::value>::template 
+                function<Helper>(Grd,xs,n,out);
+        }
+    };
+   
+    namespace _hint_impl{
+        struct not_hintable{};
+
+        template <typename Helper,typename cnt_type,typename T>
+        auto pos_hint_check(Helper *,cnt_type const & Grd,T const & x)
+            ->decltype(Helper::pos_hint_impl(Grd,x,size_t(0)));
+        not_hintable pos_hint_check(...);
+
+        /// @brief checks if Helper has static pos_hint_impl(Grd,x,hint)
+        template <typename Helper,typename cnt_type,typename T>
+        struct has_pos_hint: templdefs::is_not_same<not_hintable,
+                    decltype(
+                        pos_hint_check(std::declval<Helper *>(),std::declval<cnt_type const &>(),std::declval<T const &>())
+                    )>{};
+
+        template <bool _has_hint>
+        struct _condition_pos_hint{
+            template <typename Helper,typename cnt_type,typename T>
+            static inline constexpr size_t function(cnt_type const & Grd,T const & x,size_t) noexcept{
+                return Helper::pos_impl(Grd,x);
+            }
+        };
+        template <>
+        struct _condition_pos_hint<true>{
+            template <typename Helper,typename cnt_type,typename T>
+            static inline constexpr size_t function(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+                return Helper::pos_hint_impl(Grd,x,hint);
+            }
+        };
+
+        /// @brief calls Helper::pos_hint_impl if exists, otherwise Helper::pos_impl
+        template <typename Helper,typename cnt_type,typename T>
+        inline constexpr size_t pos_hint(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return _condition_pos_hint<has_pos_hint<Helper,cnt_type,T>::value>::template 
+                function<Helper>(Grd,x,hint);
+        }
+    };
+   
     struct vector_array_grid_helper{
         template <typename cnt_type,typename T>
         constexpr inline static  size_t pos_impl(cnt_type const & Grd,T const & x) noexcept{
             return __find_index_sorted_with_guess(Grd,x);
         }
         template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_hint_impl(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return __find_index_sorted_with_hint(Grd,x,hint);
+        }
+        template <typename cnt_type,typename T>
+        inline static void pos_batch_impl(cnt_type const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+            for(size_t i=0;i<n;++i){
+                out[i] = pos_impl(Grd,xs[i]);
+            }
+        }
+        template <typename T,typename...Alloc>
+        inline static void pos_batch_impl(std::vector<T,Alloc...> const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+            _simd::sorted_pos(Grd.data(),Grd.size(),xs,n,out);
+        }
+        template <typename T,size_t N>
+        inline static void pos_batch_impl(std::array<T,N> const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+            _simd::sorted_pos(Grd.data(),N,xs,n,out);
+        }
+        template <typename T>
+        inline static void pos_batch_impl(vector_view<T> const & Grd,typename std::decay<T>::type const * xs,size_t n,size_t * out) noexcept{
+            _simd::sorted_pos(Grd.data(),Grd.size(),xs,n,out);
+        }
+        template <typename cnt_type,typename T>
         constexpr inline static bool contain_impl(cnt_type const & Grd,T const & x) noexcept{
             return Grd.front() <= x && x <= Grd.back();
         }
     };
     struct vector_array_grid_helper_nearest{
         template <typename cnt_type,typename T>
-        constexpr inline static  size_t pos_impl(cnt_type const & Grd,T const & x) noexcept{
-            size_t i =  __find_index_sorted_with_guess(Grd,x);
+        constexpr inline static  size_t nearest(cnt_type const & Grd,T const & x,size_t i) noexcept{
             if(i < 2 || x - Grd[i] < Grd[i+1] - x){
                 return i;
             } else {
@@ -76,6 +180,14 @@ namespace grob{
             }
         }
         template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_impl(cnt_type const & Grd,T const & x) noexcept{
+            return nearest(Grd,x,__find_index_sorted_with_guess(Grd,x));
+        }
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_hint_impl(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return nearest(Grd,x,__find_index_sorted_with_hint(Grd,x,hint));
+        }
+        template <typename cnt_type,typename T>
         constexpr inline static bool contain_impl(cnt_type const & Grd,T const & x) noexcept{
             return vector_array_grid_helper::contain_impl(Grd,x);
         }
@@ -142,8 +254,335 @@ namespace grob{
         }
     };
 
-    
-    
+    /**
+     * \brief sorted container of nodes with Eytzinger (BFS) ordered copy for fast search
+     * b[1] is root, children of b[k] are b[2k] and b[2k+1],
+     * rank[k] is index of b[k] in sorted nodes, rank[0] = size()
+    */
+    template <typename T>
+    struct EytzingerContainer{
+        protected:
+        std::vector<T> _nodes;
+        std::vector<T> _eytz;
+        std::vector<size_t> _rank;
+        friend struct vector_array_grid_helper_eytzinger;
+
+        inline void _build(size_t & i,size_t k){
+            if(k <= _nodes.size()){
+                _build(i,2*k);
+                _eytz[k] = _nodes[i];
+                _rank[k] = i++;
+                _build(i,2*k + 1);
+            }
+        }
+        inline void _build(){
+            _eytz.resize(_nodes.size() + 1);
+            _rank.resize(_nodes.size() + 1);
+            _eytz[0] = T();
+            _rank[0] = _nodes.size();
+            size_t i = 0;
+            _build(i,1);
+        }
+        public:
+        typedef T value_type;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+        inline EytzingerContainer(){
+            _build();
+        }
+
+        /// @brief constructor
+        /// @param nodes sorted nodes of grid
+        inline EytzingerContainer(std::vector<T> nodes):_nodes(std::move(nodes)){
+            _build();
+        }
+        inline EytzingerContainer(std::initializer_list<T> nodes):_nodes(nodes){
+            _build();
+        }
+        template <typename Iterator>
+        inline EytzingerContainer(Iterator first,Iterator last):_nodes(first,last){
+            _build();
+        }
+
+        /// @brief sorted nodes
+        inline std::vector<T> const & nodes() const noexcept{return _nodes;}
+        inline operator std::vector<T> const &() const noexcept{return _nodes;}
+
+        inline size_t size() const noexcept{return _nodes.size();}
+        inline T const & operator[](size_t i) const noexcept{return _nodes[i];}
+        inline T const & front() const noexcept{return _nodes.front();}
+        inline T const & back() const noexcept{return _nodes.back();}
+        inline T const * data() const noexcept{return _nodes.data();}
+
+        inline const_iterator begin() const noexcept{return _nodes.cbegin();}
+        inline const_iterator end() const noexcept{return _nodes.cend();}
+        inline const_iterator cbegin() const noexcept{return _nodes.cbegin();}
+        inline const_iterator cend() const noexcept{return _nodes.cend();}
+
+        /// @brief printing to stream
+        friend void __print_container__ (std::ostream & os,const EytzingerContainer & VG){
+            std::ostringstream internal_stream;
+            internal_stream << "Eytzinger(" << VG.size() << ")[";
+            if(VG.size()){
+                internal_stream << VG[0];
+            }
+            for(size_t i=1;i<VG.size();++i){
+                internal_stream << ", " <<VG[i];
+            }
+            internal_stream << "]";
+            os << internal_stream.str();
+        }
+
+        /// @brief debuging to stream
+        friend std::ostream & operator << (std::ostream & os,const EytzingerContainer & VG){
+            __print_container__(os,VG);
+            return os;
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("nodes"),PROPERTIES(_nodes))
+        WRITE_FUNCTION(_nodes)
+        DESERIALIZATOR_FUNCTION(EytzingerContainer,PROPERTY_NAMES("nodes"),PROPERTY_TYPES(_nodes))
+        READ_FUNCTION(EytzingerContainer,PROPERTY_TYPES(_nodes))
+    };
+
+    template <typename T>
+    struct __default_grid_constructor__<EytzingerContainer<T>>{
+        constexpr static bool constructable = true;
+        static inline EytzingerContainer<T> construct(T const &a,T const & b,size_t size){
+            return __default_grid_constructor__<std::vector<T>>::construct(a,b,size);
+        }
+    };
+
+    /// @brief same as vector_array_grid_helper, but for EytzingerContainer
+    /// uses branchless descent over Eytzinger layout with prefetching,
+    /// so latency of pos grows slowly with grid size
+    struct vector_array_grid_helper_eytzinger{
+        private:
+        /// @brief sorted index by Eytzinger index k after descent
+        template <typename T>
+        static inline size_t _from_descent(EytzingerContainer<T> const & _self,size_t k) noexcept{
+            // k is the Eytzinger index of first node > x (0 if no such node)
+            k >>= _simd::count_trailing_ones(k) + 1;
+            size_t r = _self._rank[k];
+            r -= (r != 0);
+            return r < _self.size() - 2 ? r : _self.size() - 2;
+        }
+        public:
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_impl(cnt_type const & Grd,T const & x) noexcept{
+            return __find_index_sorted_with_guess(Grd,x);
+        }
+        /// @brief local search over sorted nodes, cheaper than descent for near hint
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_hint_impl(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return __find_index_sorted_with_hint(Grd,x,hint);
+        }
+        template <typename T,typename U>
+        inline static size_t pos_impl(EytzingerContainer<T> const & _self,U const & x) noexcept{
+            const size_t n = _self.size();
+            if(n < 2)
+                return 0;
+            const T * b = _self._eytz.data();
+            // children of k several levels below are adjacent, fetch them ahead
+            constexpr size_t block = (64/sizeof(T) ? 64/sizeof(T) : 1);
+            size_t k = 1;
+            while(k <= n){
+                GROB_PREFETCH(b + k*block);
+                k = 2*k + !(x < b[k]);
+            }
+            return _from_descent(_self,k);
+        }
+
+        /// @brief descent of several queries in lockstep to overlap cache misses
+        template <typename T,typename U>
+        inline static void pos_batch_impl(EytzingerContainer<T> const & _self,U const * xs,size_t n,size_t * out) noexcept{
+            const size_t N = _self.size();
+            if(N < 2){
+                std::fill(out,out+n,size_t(0));
+                return;
+            }
+            const T * b = _self._eytz.data();
+            constexpr size_t lanes = 8;
+            constexpr size_t block = (64/sizeof(T) ? 64/sizeof(T) : 1);
+            // number of full levels of tree: all k stay <= N during them
+            size_t full_levels = 0;
+            for(size_t m = N + 1;m > 1;m >>= 1,++full_levels);
+
+            size_t i = 0;
+            for(;i + lanes <= n;i += lanes){
+                size_t k[lanes];
+                for(size_t l=0;l<lanes;++l)
+                    k[l] = 1;
+                for(size_t level=0;level<full_levels;++level){
+                    for(size_t l=0;l<lanes;++l){
+                        GROB_PREFETCH(b + k[l]*block);
+                        k[l] = 2*k[l] + !(xs[i+l] < b[k[l]]);
+                    }
+                }
+                for(size_t l=0;l<lanes;++l){
+                    if(k[l] <= N)
+                        k[l] = 2*k[l] + !(xs[i+l] < b[k[l]]);
+                    out[i+l] = _from_descent(_self,k[l]);
+                }
+            }
+            for(;i<n;++i){
+                out[i] = pos_impl(_self,xs[i]);
+            }
+        }
+
+        template <typename cnt_type,typename T>
+        constexpr inline static bool contain_impl(cnt_type const & Grd,T const & x) noexcept{
+            return Grd.front() <= x && x <= Grd.back();
+        }
+    };
+
+    /**
+     * \brief sorted container of nodes with uniform bucket table for O(1) search
+     * bucket of x is size_t_cast((x-front())*buckets/(back()-front()),buckets-1),
+     * table[j] is number of nodes with bucket < j, so for x in bucket j
+     * pos(x) lies in [table[j]-1,table[j+1]-1]
+    */
+    template <typename T>
+    struct BucketContainer{
+        protected:
+        std::vector<T> _nodes;
+        std::vector<size_t> _table;
+        size_t _buckets;
+        T _fac;
+        friend struct vector_array_grid_helper_bucket;
+
+        inline size_t _bucket(T const & x) const noexcept{
+            return _detail::size_t_cast((x - _nodes.front()) * _fac,_buckets - 1);
+        }
+        inline void _build(){
+            if(!_buckets){
+                _buckets = (_nodes.size() ? _nodes.size() : 1);
+            }
+            _table.assign(_buckets + 1,0);
+            if(_nodes.size() < 2){
+                _fac = 0;
+                return;
+            }
+            T L = _nodes.back() - _nodes.front();
+            _fac = (L > 0 ? _buckets / L : T(0));
+            for(size_t i=0;i<_nodes.size();++i){
+                ++_table[_bucket(_nodes[i]) + 1];
+            }
+            for(size_t j=0;j<_buckets;++j){
+                _table[j+1] += _table[j];
+            }
+        }
+        public:
+        typedef T value_type;
+        typedef typename std::vector<T>::const_iterator const_iterator;
+
+        inline BucketContainer():_buckets(1){
+            _build();
+        }
+
+        /// @brief constructor
+        /// @param nodes sorted nodes of grid
+        /// @param buckets number of buckets, 0 means nodes.size(),
+        /// more buckets - more memory and less comparisons for clustered nodes
+        inline BucketContainer(std::vector<T> nodes,size_t buckets = 0):
+            _nodes(std::move(nodes)),_buckets(buckets){
+            _build();
+        }
+        inline BucketContainer(std::initializer_list<T> nodes):_nodes(nodes),_buckets(0){
+            _build();
+        }
+        template <typename Iterator>
+        inline BucketContainer(Iterator first,Iterator last):
+            _nodes(first,last),_buckets(0){
+            _build();
+        }
+
+        /// @brief rebuilds table with new number of buckets
+        inline void rebuild(size_t buckets){
+            _buckets = buckets;
+            _build();
+        }
+        inline size_t buckets() const noexcept{return _buckets;}
+
+        /// @brief sorted nodes
+        inline std::vector<T> const & nodes() const noexcept{return _nodes;}
+        inline operator std::vector<T> const &() const noexcept{return _nodes;}
+
+        inline size_t size() const noexcept{return _nodes.size();}
+        inline T const & operator[](size_t i) const noexcept{return _nodes[i];}
+        inline T const & front() const noexcept{return _nodes.front();}
+        inline T const & back() const noexcept{return _nodes.back();}
+        inline T const * data() const noexcept{return _nodes.data();}
+
+        inline const_iterator begin() const noexcept{return _nodes.cbegin();}
+        inline const_iterator end() const noexcept{return _nodes.cend();}
+        inline const_iterator cbegin() const noexcept{return _nodes.cbegin();}
+        inline const_iterator cend() const noexcept{return _nodes.cend();}
+
+        /// @brief printing to stream
+        friend void __print_container__ (std::ostream & os,const BucketContainer & VG){
+            std::ostringstream internal_stream;
+            internal_stream << "Bucket(" << VG.size() << ", buckets = " << VG._buckets << ")[";
+            if(VG.size()){
+                internal_stream << VG[0];
+            }
+            for(size_t i=1;i<VG.size();++i){
+                internal_stream << ", " <<VG[i];
+            }
+            internal_stream << "]";
+            os << internal_stream.str();
+        }
+
+        /// @brief debuging to stream
+        friend std::ostream & operator << (std::ostream & os,const BucketContainer & VG){
+            __print_container__(os,VG);
+            return os;
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("nodes","buckets"),PROPERTIES(_nodes,_buckets))
+        WRITE_FUNCTION(_nodes,_buckets)
+        DESERIALIZATOR_FUNCTION(BucketContainer,PROPERTY_NAMES("nodes","buckets"),PROPERTY_TYPES(_nodes,_buckets))
+        READ_FUNCTION(BucketContainer,PROPERTY_TYPES(_nodes,_buckets))
+    };
+
+    template <typename T>
+    struct __default_grid_constructor__<BucketContainer<T>>{
+        constexpr static bool constructable = true;
+        static inline BucketContainer<T> construct(T const &a,T const & b,size_t size){
+            return __default_grid_constructor__<std::vector<T>>::construct(a,b,size);
+        }
+    };
+
+    /// @brief same as vector_array_grid_helper, but for BucketContainer:
+    /// table read and bisection inside one bucket
+    struct vector_array_grid_helper_bucket{
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_impl(cnt_type const & Grd,T const & x) noexcept{
+            return __find_index_sorted_with_guess(Grd,x);
+        }
+        template <typename T,typename U>
+        inline static size_t pos_impl(BucketContainer<T> const & _self,U const & x) noexcept{
+            const size_t N = _self.size();
+            if(N < 2)
+                return 0;
+            size_t j = _self._bucket(x);
+            size_t i0 = _self._table[j];
+            size_t i1 = _self._table[j+1];
+            i0 -= (i0 != 0);
+            i0 = (i0 < N - 2 ? i0 : N - 2);
+            i1 = (i1 < N - 1 ? i1 : N - 1);
+            return __find_index_sorted_corrector(_self._nodes,x,i0,i1);
+        }
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_hint_impl(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return __find_index_sorted_with_hint(Grd,x,hint);
+        }
+        template <typename cnt_type,typename T>
+        constexpr inline static bool contain_impl(cnt_type const & Grd,T const & x) noexcept{
+            return Grd.front() <= x && x <= Grd.back();
+        }
+    };
+
     struct int_indexer{
         template <typename Container>
         inline constexpr static size_t  LinearIndex(Container const& _cnt,size_t i) noexcept{return i;}
@@ -161,6 +600,164 @@ namespace grob{
         inline constexpr static bool IsEnd(Container const& _cnt,size_t i) noexcept{return i == _cnt.size();}
     };
 
+    /// @brief stateful locator for correlated queries:
+    /// each locate starts search from previous found index
+    /// @tparam GridType Grid1 or MultiGrid, should have pos_hint(hint,x...)
+    template <typename GridType>
+    struct GridCursor{
+        typedef typename GridType::MultiIndexType MultiIndexType;
+        protected:
+        GridType const * _grid;
+        MultiIndexType _index;
+        public:
+        inline GridCursor(GridType const & _grid) noexcept:
+            _grid(&_grid),_index(_grid.MultiZero()){}
+        inline GridCursor(GridType const & _grid,MultiIndexType _index) noexcept:
+            _grid(&_grid),_index(_index){}
+
+        /// @brief same as grid().pos(args...), but starts from last located index.
+        /// For x equal to node of sorted grid gives the cell, starting at this node
+        template <typename...Args>
+        inline MultiIndexType const & locate(Args const&...args) noexcept{
+            _index = _grid->pos_hint(_index,args...);
+            return _index;
+        }
+        /// @brief tuple version of locate(args...)
+        template <size_t tuple_index = 0,typename...Args>
+        inline MultiIndexType const & locate_tuple(std::tuple<Args...> const & X) noexcept{
+            _index = _grid->template pos_hint_tuple<tuple_index>(_index,X);
+            return _index;
+        }
+
+        inline MultiIndexType const & index() const noexcept{return _index;}
+        inline void reset(MultiIndexType _new_index) noexcept{_index = _new_index;}
+        inline GridType const & grid() const noexcept{return *_grid;}
+    };
+
+    /// @brief range [begin, end) of linear indexes of grid, start is MultiIndex of begin
+    template <typename MultiIndexType>
+    struct IndexRange{
+        size_t begin;
+        size_t end;
+        MultiIndexType start;
+        inline size_t size() const noexcept{return end - begin;}
+    };
+
+    /// @brief splits grid into k balanced ranges of linear indexes,
+    /// so that each range can be traversed independently, e.g. in separate thread
+    /// @return vector of k IndexRange (empty ranges if k > Grid.size())
+    template <typename GridType>
+    std::vector<IndexRange<typename GridType::MultiIndexType>> partition_grid(GridType const & Grid,size_t k){
+        if(k == 0)
+            k = 1;
+        size_t N = Grid.size();
+        std::vector<IndexRange<typename GridType::MultiIndexType>> ranges;
+        ranges.reserve(k);
+        for(size_t j=0;j<k;++j){
+            size_t begin = j*N/k;
+            size_t end = (j+1)*N/k;
+            ranges.push_back({begin,end,begin < end ? Grid.FromLinear(begin) : Grid.MultiZero()});
+        }
+        return ranges;
+    }
+
+    namespace _enumerate_impl{
+        /// @brief keeps grid by pointer if GridRef is reference, and by value otherwise (views of inner grids)
+        template <typename GridRef>
+        struct grid_holder{
+            typename std::decay<GridRef>::type value;
+            inline void set(GridRef && g){value = std::move(g);}
+            inline auto const & get() const noexcept{return value;}
+        };
+        template <typename GridType>
+        struct grid_holder<GridType &>{
+            GridType * ptr = nullptr;
+            inline void set(GridType & g) noexcept{ptr = &g;}
+            inline GridType const & get() const noexcept{return *ptr;}
+        };
+
+        /**
+         * \brief sweeps grid in order of linear indexes: value() is grid[index()],
+         * next() moves to the next point and returns false after the last one.
+         * Generic version uses MultiIncrement and operator[] of grid,
+         * nested grids (MultiGrid) specialize it to advance row by row
+        */
+        template <typename GridRef,typename = void>
+        struct walker{
+            typedef typename std::decay<GridRef>::type Grid_t;
+            typedef typename Grid_t::MultiIndexType MultiIndexType;
+            grid_holder<GridRef> _grid;
+            MultiIndexType _index;
+
+            inline void init(GridRef && grid,MultiIndexType const & mi){
+                _grid.set(std::forward<GridRef>(grid));
+                _index = mi;
+            }
+            inline MultiIndexType const & index() const noexcept{return _index;}
+            inline decltype(auto) value() const noexcept{return _grid.get()[_index];}
+            inline bool next() noexcept{
+                _grid.get().MultiIncrement(_index);
+                return !_grid.get().IsEnd(_index);
+            }
+        };
+    };
+
+    /// @brief view for sweep over grid (or its range), yields tuple(multi_index, linear_index, coordinate),
+    /// linear index is carried along with multi index instead of calling LinearIndex,
+    /// nested grids are advanced row by row (see _enumerate_impl::walker)
+    /// @tparam GridType any grid with MultiZero, MultiIncrement and operator[]
+    template <typename GridType>
+    struct GridEnumerator{
+        typedef typename GridType::MultiIndexType MultiIndexType;
+        protected:
+        GridType const & _grid;
+        MultiIndexType _start;
+        size_t _begin;
+        size_t _end;
+        public:
+        inline GridEnumerator(GridType const & _grid) noexcept:
+            _grid(_grid),_start(_grid.MultiZero()),_begin(0),_end(_grid.size()){}
+        inline GridEnumerator(GridType const & _grid,IndexRange<MultiIndexType> const & _range) noexcept:
+            _grid(_grid),_start(_range.start),_begin(_range.begin),_end(_range.end){}
+
+        struct iterator{
+            protected:
+            _enumerate_impl::walker<GridType const &> _walker;
+            size_t Linear;
+            public:
+            inline iterator(GridType const & _grid,MultiIndexType const & Position,size_t Linear) noexcept:
+                Linear(Linear){
+                    _walker.init(_grid,Position);
+                }
+            /// @brief end iterator, compared by linear index only
+            inline iterator(size_t Linear) noexcept:Linear(Linear){}
+
+            inline decltype(auto) index() const noexcept{return _walker.index();}
+            inline size_t linear_index() const noexcept{return Linear;}
+            /// @brief grid[index()]
+            inline decltype(auto) point() const noexcept{return _walker.value();}
+
+            inline iterator & operator ++() noexcept{
+                _walker.next();
+                ++Linear;
+                return *this;
+            }
+            inline auto operator *() const noexcept{
+                return std::tuple<MultiIndexType,size_t,decltype(_walker.value())>(
+                    _walker.index(),Linear,_walker.value());
+            }
+            inline bool operator !=(iterator const & other) const noexcept{
+                return Linear != other.Linear;
+            }
+        };
+        inline iterator begin() const noexcept{
+            return (_begin < _end ? iterator(_grid,_start,_begin) : iterator(_end));
+        }
+        inline iterator end() const noexcept{
+            return iterator(_end);
+        }
+    };
+
     /// @brief one-dimention grid managed by Container
     /// @tparam Container type of container
     /// @tparam Helper struct which has static implementations: 
@@ -202,6 +799,46 @@ namespace grob{
             return Helper::pos_impl(*this,std::get<tuple_index>(X));
         }
 
+        /// @brief same as pos(x), but search starts from hint,
+        /// gives O(1) for sequential queries on non-uniform grids
+        /// @param hint expected index, e.g. result of previous call
+        template <typename T>
+        constexpr inline size_t pos_hint(size_t hint,T const  &x) const noexcept{
+            return _hint_impl::pos_hint<Helper>(container(),x,hint);
+        }
+
+        /// @brief tuple version of pos_hint(hint,x)
+        template <size_t tuple_index = 0,typename...Args>
+        constexpr inline size_t pos_hint_tuple(size_t hint,std::tuple<Args...> const  &X) const noexcept{
+            return _hint_impl::pos_hint<Helper>(container(),std::get<tuple_index>(X),hint);
+        }
+
+        /// @brief makes cursor, which locates points near previous located
+        inline GridCursor<Grid1> cursor() const noexcept{
+            return GridCursor<Grid1>(*this);
+        }
+
+        /// @brief view, yielding (index, linear index, grid[index]) for each point
+        inline GridEnumerator<Grid1> enumerate() const noexcept{
+            return GridEnumerator<Grid1>(*this);
+        }
+
+        /// @brief k balanced ranges of indexes, watch partition_grid
+        inline auto partition(size_t k) const{
+            return partition_grid(*this,k);
+        }
+
+        /// @brief batch version of pos(x), vectorized for uniform and vector grids
+        /// @param xs array of n coords
+        /// @param n 
+        /// @param out array of n indexes, out[k] = pos(xs[k])
+        template <typename T>
+        inline void pos_batch(const T * xs,size_t n,size_t * out) const noexcept{
+            _batch_impl::pos_batch<Helper>(container(),xs,n,out);
+        }
+
+        Grid1() = default;
+
         /// @brief main constructor of grid from container
         /// @param _cnt base container of grid 
         Grid1 (Container _cnt):Container(std::forward<Container>(_cnt)){}
@@ -282,6 +919,32 @@ namespace grob{
             std::tie(b,index_to_fill) = spos(std::get<tuple_index>(_Tp));
 
         }
+
+        /// @brief checks x and finds linear index of bin in one pass
+        /// @return LinearIndex(pos(x)) if grid contains x, and nullopt otherwise
+        template <typename U>
+        inline std::optional<size_t> locate_linear(U const & x) const noexcept{
+            if(!contains(x))
+                return std::nullopt;
+            return LinearIndex(pos(x));
+        }
+
+        /// @brief tuple version of locate_linear(x)
+        template <size_t tuple_index = 0,typename...Args>
+        inline std::optional<size_t> locate_linear_tuple(std::tuple<Args...> const & X) const noexcept{
+            return locate_linear(std::get<tuple_index>(X));
+        }
+
+        /// @brief adds linear index of std::get<tuple_index>(_Tp) to offset
+        /// @return false if grid doesn't contain x
+        template <size_t tuple_index = 0,typename Tuple>
+        inline bool locate_linear_impl(Tuple const & _Tp,size_t & offset) const noexcept{
+            auto const & x = std::get<tuple_index>(_Tp);
+            if(!contains(x))
+                return false;
+            offset += LinearIndex(pos(x));
+            return true;
+        }
         
         
 
@@ -358,6 +1021,7 @@ namespace grob{
             noexcept:CBase(cnt.unhisto()){}
         
 
+        numerical_histo_container() = default;
         constexpr inline numerical_histo_container(CBase cnt)noexcept:CBase(std::move(cnt)){}
         
         INHERIT_DESERIALIZATOR(CBase,numerical_histo_container)
@@ -422,6 +1086,14 @@ namespace grob{
         constexpr inline static bool contain_impl(cnt_type const & Grd,T const & x) noexcept{
             return base_helper::contain_impl(unhisto(Grd),x);
         }
+        template <typename cnt_type,typename T>
+        inline static void pos_batch_impl(cnt_type const & Grd,T const * xs,size_t n,size_t * out) noexcept{
+            _batch_impl::pos_batch<base_helper>(unhisto(Grd),xs,n,out);
+        }
+        template <typename cnt_type,typename T>
+        constexpr inline static  size_t pos_hint_impl(cnt_type const & Grd,T const & x,size_t hint) noexcept{
+            return _hint_impl::pos_hint<base_helper>(unhisto(Grd),x,hint);
+        }
     };
 
 
@@ -591,6 +1263,10 @@ namespace grob{
 
         }
 
+        /// @brief constructor with precomputed 1/(size-1) and (size-1)/(b-a), avoids divisions
+        constexpr inline UniformContainer(T  a, T   b,size_t _size,T _fac,T _h_1)
+        noexcept:a(a),b(b),_fac(_fac),_h_1 (_h_1),_size(_size){}
+
         template <typename...VectorArgs>
         operator std::vector<VectorArgs...>() const {
             std::vector<VectorArgs...> ret;
@@ -688,6 +1364,113 @@ namespace grob{
         DESERIALIZATOR_FUNCTION(UniformContainer,PROPERTY_NAMES("a","b","size"),PROPERTY_TYPES(a,b,_size))
         READ_FUNCTION(UniformContainer,PROPERTY_TYPES(a,b,_size))
     };
+    /**
+     * \brief compile time version of UniformContainer: N points from A to B,
+     * a, b, h, h_inv are constexpr, so grid can be used in constant expressions and takes no storage.
+     * Lookups run at the speed of UniformContainer (see tests/bench_uniform_static.cpp)
+     * @tparam A,B std::ratio bounds
+    */
+    template <typename T,size_t N,typename A = std::ratio<0>,typename B = std::ratio<1>>
+    struct UniformStaticContainer{
+        static_assert(N >= 2,"UniformStaticContainer: size should be at least 2");
+        constexpr static T a = static_cast<T>(A::num)/static_cast<T>(A::den);
+        constexpr static T b = static_cast<T>(B::num)/static_cast<T>(B::den);
+        constexpr static T _fac = ((T)1)/(N-1);
+        constexpr static T _h_1 = (N-1)/(b-a);
+        static_assert(a < b,"UniformStaticContainer: A should be less than B");
+
+        typedef T value_type;
+
+        constexpr inline UniformStaticContainer() noexcept{}
+
+        template <typename...VectorArgs>
+        operator std::vector<VectorArgs...>() const {
+            std::vector<VectorArgs...> ret;
+            ret.reserve(N);
+            for(size_t i=0;i<N;++i){
+                ret.push_back((*this)[i]);
+            }
+            return ret;
+        }
+
+        /// @brief conversion to runtime uniform container
+        constexpr inline operator UniformContainer<T>() const noexcept{
+            return UniformContainer<T>(a,b,N);
+        }
+
+        /// @brief printing to stream
+        friend void __print_container__ (std::ostream & os,const UniformStaticContainer &){
+            std::stringstream internal_stream;
+            internal_stream << "UniformStatic(" << N << ")[" << a <<", "<< b;
+            internal_stream << "]";
+            os << internal_stream.str();
+        }
+
+        constexpr inline static T front() noexcept{return a;}
+        constexpr inline static T back() noexcept{return b;}
+        constexpr inline static T h() noexcept{return (b-a)*_fac;}
+        constexpr inline static T h_inv() noexcept{return _h_1;}
+        constexpr inline static size_t size() noexcept{return N;}
+
+        /// @brief accessor to element, same formula as UniformContainer
+        constexpr inline T operator[](size_t i) const noexcept{
+            return (a*(N-i-1) + i*b)*_fac;
+        }
+
+        /// @brief iterator class
+        typedef _const_iterator_template<const UniformStaticContainer,T> const_iterator;
+
+        inline const_iterator begin()const noexcept{return const_iterator(*this,0);}
+        inline const_iterator end()const noexcept{return const_iterator(*this,N);}
+        inline const_iterator cbegin()const noexcept{return const_iterator(*this,0);}
+        inline const_iterator cend()const noexcept{return const_iterator(*this,N);}
+
+        /// @brief debuging to stream
+        friend std::ostream & operator << (std::ostream & os,const UniformStaticContainer & VG){
+            __print_container__(os,VG);
+            return os;
+        }
+
+        /// @brief checks stored parameters, throws std::range_error on mismatch
+        static UniformStaticContainer check(T _a,T _b,size_t _size){
+            if(_a != a || _b != b || _size != N){
+                std::ostringstream S;
+                S << "UniformStaticContainer: expected (" << a << ", " << b << ", " << N <<
+                    "), got (" << _a << ", " << _b << ", " << _size << ")";
+                throw std::range_error(S.str());
+            }
+            return UniformStaticContainer();
+        }
+
+        template <typename Serializer>
+        auto Serialize(Serializer && S)const{
+            static const auto names = PROPERTY_NAMES("a","b","size");
+            const T _a = a,_b = b;
+            const size_t _size = N;
+            return S.MakeDict(names,PROPERTIES(_a,_b,_size));
+        }
+        template <typename Writer>
+        void write(Writer && w)const{
+            w.write(a);
+            w.write(b);
+            w.write(N);
+        }
+        template <typename Object,typename DeSerializer>
+        static UniformStaticContainer DeSerialize(Object && Obj,DeSerializer && DS){
+            return check(stools::DeSerialize<T>(DS.GetProperty(Obj,"a"),DS),
+                        stools::DeSerialize<T>(DS.GetProperty(Obj,"b"),DS),
+                        stools::DeSerialize<size_t>(DS.GetProperty(Obj,"size"),DS));
+        }
+        template <typename Reader>
+        static UniformStaticContainer read(Reader && r){
+            T _a,_b;
+            size_t _size;
+            r.read(_a);
+            r.read(_b);
+            r.read(_size);
+            return check(_a,_b,_size);
+        }
+    };
     struct uniform_grid_helper{
         template <typename T,typename U>
         static constexpr size_t pos_impl(UniformContainer<T> const & _self,U const & x)noexcept{
@@ -697,6 +1480,142 @@ namespace grob{
         static inline constexpr bool contain_impl(UniformContainer<T> const & _self,U const & x)noexcept{
             return _self.a<=x && x<=_self.b;
         }
+        template <typename T,typename U>
+        static inline void pos_batch_impl(UniformContainer<T> const & _self,U const * xs,size_t n,size_t * out)noexcept{
+            _simd::uniform_pos(_self.a,_self._h_1,_self.size() - 2,xs,n,out);
+        }
+
+        template <typename T,size_t N,typename A,typename B,typename U>
+        static constexpr size_t pos_impl(UniformStaticContainer<T,N,A,B> const &,U const & x)noexcept{
+            typedef UniformStaticContainer<T,N,A,B> C;
+            return _detail::size_t_cast((x - C::a) * C::_h_1, N - 2);
+        }
+        template <typename T,size_t N,typename A,typename B,typename U>
+        static inline constexpr bool contain_impl(UniformStaticContainer<T,N,A,B> const &,U const & x)noexcept{
+            typedef UniformStaticContainer<T,N,A,B> C;
+            return C::a<=x && x<=C::b;
+        }
+        template <typename T,size_t N,typename A,typename B,typename U>
+        static inline void pos_batch_impl(UniformStaticContainer<T,N,A,B> const &,U const * xs,size_t n,size_t * out)noexcept{
+            typedef UniformStaticContainer<T,N,A,B> C;
+            _simd::uniform_pos(C::a,C::_h_1,N - 2,xs,n,out);
+        }
+    };
+
+    /**
+     * \brief log-linear (HdrHistogram-like) pseudo vector of positive points:
+     * every octave [2^e,2^(e+1)) is split into 2^sub_bits equal parts,
+     * index of x is computed from exponent and top mantissa bits of x, without log.
+     * nodes snap to this lattice, so front() <= a and back() >= b
+    */
+    template <typename T>
+    struct LogLinearContainer{
+        static_assert(std::is_floating_point<T>::value && (sizeof(T) == 8 || sizeof(T) == 4),
+            "LogLinearContainer: T should be float or double");
+        protected:
+        typedef typename std::conditional<sizeof(T) == 8,int64_t,int32_t>::type int_t;
+        constexpr static unsigned _mantissa = (sizeof(T) == 8 ? 52 : 23);
+
+        T a;
+        T b;
+        size_t _sub_bits;
+        unsigned _shift;
+        long long _first; /// key of front()
+        size_t _size;
+        friend struct loglinear_grid_helper;
+
+        inline long long key(T x) const noexcept{
+            int_t bits;
+            std::memcpy(&bits,&x,sizeof(T));
+            return static_cast<long long>(bits >> _shift);
+        }
+        inline T from_key(long long k) const noexcept{
+            int_t bits = static_cast<int_t>(k) << _shift;
+            T x;
+            std::memcpy(&x,&bits,sizeof(T));
+            return x;
+        }
+        public:
+        typedef T value_type;
+
+        /// @brief constructor
+        /// @param a lower bound, a > 0
+        /// @param b upper bound, b > a
+        /// @param sub_bits log2 of number of bins per octave,
+        /// relative width of bin is at most 2^(-sub_bits)
+        inline LogLinearContainer(T a = 1,T b = 2,size_t sub_bits = 4) noexcept:
+            a(a),b(b),_sub_bits(sub_bits < _mantissa ? sub_bits : _mantissa),
+            _shift(static_cast<unsigned>(_mantissa - _sub_bits)){
+            _first = key(a);
+            long long last = key(b);
+            if(from_key(last) < b){
+                ++last;
+            }
+            _size = (last > _first ? static_cast<size_t>(last - _first) + 1 : 2);
+        }
+
+        template <typename...VectorArgs>
+        operator std::vector<VectorArgs...>() const {
+            std::vector<VectorArgs...> ret;
+            ret.reserve(_size);
+            for(size_t i=0;i<_size;++i){
+                ret.push_back((*this)[i]);
+            }
+            return ret;
+        }
+
+        /// @brief printing to stream
+        friend void __print_container__ (std::ostream & os,const LogLinearContainer & VG){
+            std::stringstream internal_stream;
+            internal_stream << "LogLinear(" << VG._size << ", sub_bits = " << VG._sub_bits <<
+                ")[" << VG.front() <<", "<< VG.back();
+            internal_stream << "]";
+            os << internal_stream.str();
+        }
+
+        inline size_t sub_bits() const noexcept{return _sub_bits;}
+
+        inline T front() const noexcept{return from_key(_first);}
+        inline T back() const noexcept{return from_key(_first + static_cast<long long>(_size) - 1);}
+        inline size_t size() const noexcept{return _size;}
+
+        /// @brief accessor to element 
+        inline T operator[](size_t i) const noexcept{
+            return from_key(_first + static_cast<long long>(i));
+        }
+
+        /// @brief iterator class
+        typedef _const_iterator_template<const LogLinearContainer,T> const_iterator;
+
+        inline const_iterator begin()const noexcept{return const_iterator(*this,0);}
+        inline const_iterator end()const noexcept{return const_iterator(*this,_size);}
+        inline const_iterator cbegin()const noexcept{return const_iterator(*this,0);}
+        inline const_iterator cend()const noexcept{return const_iterator(*this,_size);}
+
+        /// @brief debuging to stream
+        friend std::ostream & operator << (std::ostream & os,const LogLinearContainer & VG){
+            __print_container__(os,VG);
+            return os;
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("a","b","sub_bits"),PROPERTIES(a,b,_sub_bits))
+        WRITE_FUNCTION(a,b,_sub_bits)
+        DESERIALIZATOR_FUNCTION(LogLinearContainer,PROPERTY_NAMES("a","b","sub_bits"),PROPERTY_TYPES(a,b,_sub_bits))
+        READ_FUNCTION(LogLinearContainer,PROPERTY_TYPES(a,b,_sub_bits))
+    };
+    struct loglinear_grid_helper{
+        template <typename T,typename U>
+        static inline size_t pos_impl(LogLinearContainer<T> const & _self,U const & x)noexcept{
+            return _simd::loglinear_index(static_cast<T>(x),_self._first,_self._shift,_self.size() - 2);
+        }
+        template <typename T,typename U>
+        static inline bool contain_impl(LogLinearContainer<T> const & _self,U const & x)noexcept{
+            return _self.front()<=x && x<=_self.back();
+        }
+        template <typename T>
+        static inline void pos_batch_impl(LogLinearContainer<T> const & _self,T const * xs,size_t n,size_t * out)noexcept{
+            _simd::loglinear_pos(_self._first,_self._shift,_self.size() - 2,xs,n,out);
+        }
     };
 
     /// @brief container whose values are results of function applied to uniform container
@@ -728,8 +1647,10 @@ namespace grob{
         /// @param _size size of range
         /// @param _to_hidden rising function, which maps a..b -> a'..b'
         /// @param _from_hidden rising function, which maps a'..b' -> a..b
+        /// (may be omitted for default constructible functors, e.g. LogTransform)
         constexpr inline FunctionalContainer( T a,T  b,size_t _size,
-                    FunctypeToHidden _to_hidden,FunctypeFromHidden  _from_hidden)noexcept:
+                    FunctypeToHidden _to_hidden = FunctypeToHidden{},
+                    FunctypeFromHidden  _from_hidden = FunctypeFromHidden{})noexcept:
                         _body(_to_hidden(a),_to_hidden(b),_size),
                         _to_hidden(std::forward<FunctypeToHidden>(_to_hidden)),
                         _from_hidden(std::forward<FunctypeFromHidden>(_from_hidden)){}
@@ -839,13 +1760,16 @@ namespace grob{
     auto make_func_histo_grid(T &&a, T && b,size_t _size,FunctypeToHidden && fth,
                                                     FunctypeFromHidden && ffh){
         return make_grid1<numerical_histo_helper<functional_grid_helper>>(
-                FunctionalContainer<typename std::decay<T>::type,
+                numerical_histo_container<FunctionalContainer<typename std::decay<T>::type,
+                    typename std::decay<FunctypeToHidden>::type,
+                    typename std::decay<FunctypeFromHidden>::type
+                >>(FunctionalContainer<typename std::decay<T>::type,
                     typename std::decay<FunctypeToHidden>::type,
                     typename std::decay<FunctypeFromHidden>::type
                 >(std::forward<T>(a),std::forward<T>(b),_size,
                     std::forward<FunctypeToHidden>(fth),
                     std::forward<FunctypeFromHidden>(ffh)
-                )
+                ))
         );
     } 
    
@@ -853,6 +1777,10 @@ namespace grob{
     template <typename T>
     using GridUniform = Grid1<UniformContainer<T>,uniform_grid_helper>;
     
+    /// @brief uniform grid of N points from A to B (std::ratio), all parameters are constexpr
+    template <typename T,size_t N,typename A = std::ratio<0>,typename B = std::ratio<1>>
+    using GridUniformStatic = Grid1<UniformStaticContainer<T,N,A,B>,uniform_grid_helper>;
+
     template <typename T,typename FunctypeToHidden,typename FunctypeFromHidden>
     using GridFunctional = Grid1<FunctionalContainer<T,FunctypeToHidden,FunctypeFromHidden>,
                                 functional_grid_helper>;
@@ -863,9 +1791,18 @@ namespace grob{
     template <typename T,size_t size>
     using GridArray = Grid1<std::array<T,size>,vector_array_grid_helper>;
 
+    /// @brief grid over not owned nodes, e.g. inner grid of PackedGrids
+    template <typename T>
+    using GridVectorView = Grid1<vector_view<const T>,vector_array_grid_helper>;
+
     template <typename T>
     using GridUniformHisto = Grid1<numerical_histo_container<UniformContainer<T>>,
                                     numerical_histo_helper<uniform_grid_helper>>;
+
+    /// @brief histogram version of GridUniformStatic, N is number of bins edges
+    template <typename T,size_t N,typename A = std::ratio<0>,typename B = std::ratio<1>>
+    using GridUniformStaticHisto = Grid1<numerical_histo_container<UniformStaticContainer<T,N,A,B>>,
+                                    numerical_histo_helper<uniform_grid_helper>>;
     
     template <typename T,typename FunctypeToHidden,typename FunctypeFromHidden>
     using GridFunctionalHisto = Grid1<
@@ -875,18 +1812,64 @@ namespace grob{
                                     numerical_histo_helper<functional_grid_helper>
                                 >;
 
+    template <typename T>
+    using GridLogLinear = Grid1<LogLinearContainer<T>,loglinear_grid_helper>;
+
+    template <typename T>
+    using GridLogLinearHisto = Grid1<numerical_histo_container<LogLinearContainer<T>>,
+                                    numerical_histo_helper<loglinear_grid_helper>>;
+
+    /// @brief grid, uniform in approximate log2(x), x > 0
+    template <typename T>
+    using GridLog = GridFunctional<T,LogTransform,LogTransform::inverse>;
+
+    /// @brief grid, uniform in x^(N/D)
+    template <typename T,int N,int D = 1>
+    using GridPow = GridFunctional<T,PowTransform<N,D>,typename PowTransform<N,D>::inverse>;
+
+    /// @brief grid, uniform in sqrt(x), x >= 0
+    template <typename T>
+    using GridSqrt = GridFunctional<T,SqrtTransform,SqrtTransform::inverse>;
+
+    template <typename T>
+    using GridLogHisto = GridFunctionalHisto<T,LogTransform,LogTransform::inverse>;
+
     template <typename...Args>
     using GridVectorHisto = Grid1<
                                     numerical_histo_container<std::vector<Args...>>,
                                     numerical_histo_helper<vector_array_grid_helper>
                                 >;
 
+    template <typename T>
+    using GridVectorViewHisto = Grid1<
+                                    numerical_histo_container<vector_view<const T>>,
+                                    numerical_histo_helper<vector_array_grid_helper>
+                                >;
+
     template <typename T,size_t size>
     using GridArrayHisto = Grid1<
                                     numerical_histo_container<std::array<T,size>>,
                                     numerical_histo_helper<vector_array_grid_helper>
                                 >;
 
+    template <typename T>
+    using GridEytzinger = Grid1<EytzingerContainer<T>,vector_array_grid_helper_eytzinger>;
+
+    template <typename T>
+    using GridEytzingerHisto = Grid1<
+                                    numerical_histo_container<EytzingerContainer<T>>,
+                                    numerical_histo_helper<vector_array_grid_helper_eytzinger>
+                                >;
+
+    template <typename T>
+    using GridBucket = Grid1<BucketContainer<T>,vector_array_grid_helper_bucket>;
+
+    template <typename T>
+    using GridBucketHisto = Grid1<
+                                    numerical_histo_container<BucketContainer<T>>,
+                                    numerical_histo_helper<vector_array_grid_helper_bucket>
+                                >;
+
     template <typename int_type = size_t>
     using GridRangeLight = Grid1<
                                     RangeLight<int_type>,
@@ -2,12 +2,59 @@
 #define GRID_OBJECT_HPP
 
 #include "multigrid.hpp"
+#include "rectilinear_grid.hpp"
 #include "object_serialization.hpp"
 #include "container_shift.hpp"
 #include "linear_interpolator.hpp"
 #include "point.hpp"
+#include <thread>
+#include <exception>
 namespace grob{
 
+namespace _parallel_impl{
+    /// @brief joins all joinable threads on destruction, so threads are joined on any exit from scope
+    struct joiner{
+        std::vector<std::thread> & threads;
+        inline ~joiner(){
+            for(auto & th : threads){
+                if(th.joinable())
+                    th.join();
+            }
+        }
+    };
+
+    /// @brief calls W(range) for each of n_threads ranges of Grid.partition(n_threads),
+    /// first range in calling thread, others in new threads.
+    /// All threads are joined before return, the first exception (by range order) thrown by W
+    /// is rethrown in calling thread
+    template <typename GridType,typename Worker>
+    void for_each_range(GridType const & Grid,size_t n_threads,Worker && W){
+        auto ranges = Grid.partition(n_threads);
+        std::vector<std::exception_ptr> errors(ranges.size());
+        auto run = [&W,&ranges,&errors](size_t t){
+            try{
+                W(ranges[t]);
+            }catch(...){
+                errors[t] = std::current_exception();
+            }
+        };
+        {
+            std::vector<std::thread> threads;
+            joiner J{threads};
+            threads.reserve(ranges.size() - 1);
+            for(size_t t=1;t<ranges.size();++t){
+                threads.emplace_back(run,t);
+            }
+            run(0);
+        }
+        for(auto const & e : errors){
+            if(e)
+                std::rethrow_exception(e);
+        }
+    }
+};
+
+
 
 /// @brief Base class for gridfunction/histogramm
 /// @tparam GridType anydim grid
@@ -91,6 +138,39 @@ struct GridObject{
         return const_iterator(Grid.end(),*this);
     }
 
+    /// @brief view over grid points and values, yields
+    /// tuple(multi_index, linear_index, coordinate, value &) without recomputing LinearIndex
+    template <typename GridObject_t>
+    struct enumerate_view{
+        typedef GridEnumerator<typename std::decay<GridType>::type> GEnum;
+        GridObject_t & __gobj;
+
+        struct iterator: public GEnum::iterator{
+            GridObject_t & __gobj;
+            iterator(typename GEnum::iterator __it,GridObject_t & __gobj):
+                GEnum::iterator(__it),__gobj(__gobj){}
+            inline auto operator *() const{
+                size_t li = this->linear_index();
+                return std::tuple<typename GEnum::MultiIndexType,size_t,
+                                decltype(this->point()),decltype(__gobj.Values[li])>(
+                    this->index(),li,this->point(),__gobj.Values[li]
+                );
+            }
+        };
+        inline iterator begin() const{
+            return iterator(GEnum(__gobj.Grid).begin(),__gobj);
+        }
+        inline iterator end() const{
+            return iterator(GEnum(__gobj.Grid).end(),__gobj);
+        }
+    };
+    inline enumerate_view<GridObject> enumerate(){
+        return {*this};
+    }
+    inline enumerate_view<GridObject const> enumerate() const{
+        return {*this};
+    }
+
 
 
 
@@ -138,11 +218,22 @@ struct GridObject{
     /// @param f 
     template <typename FuncType>
     void map(FuncType && f) noexcept{
-        size_t i=0;
-        for(auto MI = Grid.MultiZero(); !Grid.IsEnd(MI);++i,Grid.MultiIncrement(MI)){
-            Values[i] = f(Grid[MI]);
+        for(auto [MI,i,X,V] : enumerate()){
+            V = f(X);
         }
     }
+
+    /// @brief same as map(f), but grid is split into n_threads ranges, mapped in parallel
+    /// f should be thread safe
+    template <typename FuncType>
+    void map(FuncType && f,size_t n_threads){
+        typedef typename std::decay<GridType>::type G;
+        _parallel_impl::for_each_range(Grid,n_threads,[this,&f](auto const & range){
+            for(auto [MI,i,X] : GridEnumerator<G>(Grid,range)){
+                Values[i] = f(X);
+            }
+        });
+    }
 };
 
 /// @brief makes GridFunction from grid and vector of values
@@ -201,6 +292,44 @@ struct GridFunction:public GridObject<GridType,ContainerType>{
         return eval(args...);
     }
 
+    /// @brief value and gradient at point in one locate pass
+    /// @return pair(value, Point of Dim derivatives by coordinates), see interpolator_grad
+    template <typename...Args>
+    auto eval_grad(Args const&...args)const noexcept{
+        return interpolator_grad<Interpolator>::interpolate(GOBase::Grid,GOBase::Values,make_point(args...));
+    }
+    template <typename...Args>
+    auto eval_grad(Point<Args...> const& X)const noexcept{
+        static_assert(sizeof...(Args) == GOBase::Dim,"expect the same number of arguments");
+        return interpolator_grad<Interpolator>::interpolate(GOBase::Grid,GOBase::Values,X);
+    }
+
+    /// @brief out[k] = eval(X[k]) for n points (numbers for 1-dim grids, Point for N-dim)
+    /// uses Interpolator::interpolate_batch if exists (linear_interpolator, spline1D)
+    template <typename Point_t,typename R>
+    inline void eval_batch(const Point_t * X,size_t n,R * out) const{
+        _eval_batch_impl::interpolate_batch<Interpolator>(GOBase::Grid,GOBase::Values,X,n,out);
+    }
+
+    /// @brief out[k] = eval(axes[0][k],...,axes[Dim-1][k]) for n points, given as separate coordinate arrays
+    template <typename T,typename R>
+    void eval_batch(std::array<const T *,GOBase::Dim> const & axes,size_t n,R * out) const{
+        if constexpr (GOBase::Dim == 1){
+            eval_batch(axes[0],n,out);
+        } else {
+            constexpr size_t chunk = _eval_batch_impl::chunk;
+            auto point_maker = [](auto const &...x){return make_point(x...);};
+            decltype(std::apply(point_maker,std::array<T,GOBase::Dim>{})) points[chunk];
+            for(size_t k=0;k<n;k += chunk){
+                size_t m = (n - k < chunk ? n - k : chunk);
+                for(size_t l=0;l<m;++l){
+                    points[l] = std::apply([&](auto const *...xs){return make_point(xs[k+l]...);},axes);
+                }
+                eval_batch(points,m,out + k);
+            }
+        }
+    }
+
     /// @brief give view on inner dim grid function
     /// @tparam NewInterpolator optional new interpolator
     /// @tparam N depth of inner grid
@@ -208,7 +337,7 @@ struct GridFunction:public GridObject<GridType,ContainerType>{
     /// @return 
     template <typename NewInterpolator = Interpolator,typename MultiIndex_t>
     auto inner_slice(const MultiIndex_t & MI){
-        return GridFunction<NewInterpolator,decltype(GOBase::Grid.inner(MI)) &,decltype(make_slice(GOBase::Values,0,0))>(
+        return GridFunction<NewInterpolator,decltype(GOBase::Grid.inner(MI)),decltype(make_slice(GOBase::Values,0,0))>(
             GOBase::Grid.inner(MI),
             make_slice(
                 GOBase::Values,
@@ -221,9 +350,11 @@ struct GridFunction:public GridObject<GridType,ContainerType>{
     /// @brief same as nap, but f takes x1,...xn, not tuple(x1,...xn) 
     template <typename FuncType>
     void map_pack(FuncType && f) noexcept{
-        size_t i=0;
-        for(auto MI = GOBase::Grid.Multi0(); MI != GOBase::Grid.MultiSize();++i,GOBase::Grid.MultiIncrement(MI)){
-            GOBase::Values[i] = apply(f,GOBase::Grid[MI]);
+        for(auto [MI,i,X,V] : GOBase::enumerate()){
+            if constexpr (GOBase::Dim == 1)
+                V = f(X);
+            else
+                V = templdefs::apply_tuple(f,X.as_tuple());
         }
     }
 
@@ -265,6 +396,23 @@ auto make_function_f(GridType && Grid,LambdaType && Func){
             (std::forward<GridType>(Grid),std::move(values));
 }
 
+/// @brief parallel version of make_function_f(Grid,Func),
+/// grid is split into n_threads ranges, Func is called from different threads
+/// @param n_threads number of threads
+template <typename Interpolator = linear_interpolator,typename GridType,typename LambdaType>
+auto make_function_f(GridType && Grid,LambdaType && Func,size_t n_threads){
+    typedef typename std::decay<GridType>::type G;
+    typedef typename std::decay<decltype(templdefs::apply_tuple(Func,Grid[Grid.MultiZero()]))>::type value_type;
+    std::vector<value_type> values(Grid.size());
+    _parallel_impl::for_each_range(Grid,n_threads,[&](auto const & range){
+        for(auto [MI,i,X] : GridEnumerator<G>(Grid,range)){
+            values[i] = templdefs::apply_tuple(Func,X);
+        }
+    });
+    return GridFunction<Interpolator,G,std::vector<value_type> >
+            (std::forward<GridType>(Grid),std::move(values));
+}
+
 /// @brief makes GridFunction from grid and vector of values
 /// @tparam Interpolator interpolator class with static function interpolate(Grid,values,point)
 /// @param Grid 
@@ -312,7 +460,7 @@ struct Histogramm:public GridObject<GridType,ContainerType>{
     /// @return 
     template <typename MultiIndex_t>
     auto inner_slice(const MultiIndex_t & MI){
-        return Histogramm<decltype(GOBase::Grid.inner(MI)) &,decltype(make_slice(GOBase::Values,0,0))>(
+        return Histogramm<decltype(GOBase::Grid.inner(MI)),decltype(make_slice(GOBase::Values,0,0))>(
             this->Grid.inner(MI),
             make_slice(
                 GOBase::Values,
@@ -335,31 +483,41 @@ struct Histogramm:public GridObject<GridType,ContainerType>{
         static_assert(
             std::tuple_size<std::tuple<Arg>>::value == GOBase::Dim,
             "numbper of args mismatches dimension");
-        auto bMI = this->Grid.spos(arg);
-        if(!std::get<0>(bMI))
+        auto li = this->Grid.locate_linear(arg);
+        if(!li)
             return false;
-        else{
-            VS.put_value(
-                this->Grid.LinearIndex(std::get<1>(bMI)),
-                value,GOBase::Values
-            );
-            return true;
-        }
+        VS.put_value(*li,value,GOBase::Values);
+        return true;
     }
 
     template <size_t tuple_shift = 0,typename T,typename Point_t>
     inline bool put_point(T const& value,Point_t const & X)noexcept{
-        auto bMI = this->Grid.spos_tuple(X.as_tuple());
-        if(!std::get<0>(bMI)){
+        auto li = this->Grid.template locate_linear_tuple<tuple_shift>(X.as_tuple());
+        if(!li)
             return false;
+        VS.put_value(*li,value,GOBase::Values);
+        return true;
+    }
+
+    /// @brief puts value into bins of n points xs (for 1-dim grids), uses Grid.pos_batch.
+    /// Bins are the same as of put, also for xs on bin edges
+    /// @return number of points, contained in Grid
+    template <typename T,typename U>
+    inline size_t put_batch(T const& value,U const * xs,size_t n) noexcept{
+        constexpr size_t chunk = 256;
+        size_t indexes[chunk];
+        size_t count = 0;
+        for(size_t k=0;k<n;k += chunk){
+            size_t m = (n - k < chunk ? n - k : chunk);
+            this->Grid.pos_batch(xs + k,m,indexes);
+            for(size_t l=0;l<m;++l){
+                if(this->Grid.contains(xs[k+l])){
+                    VS.put_value(this->Grid.LinearIndex(indexes[l]),value,GOBase::Values);
+                    ++count;
+                }
+            }
         }
-        else{
-            VS.put_value(
-                this->Grid.LinearIndex(std::get<1>(bMI)),
-                value,GOBase::Values
-            );
-            return true;
-        }
+        return count;
     }
 
     template <typename T, typename...Args>
@@ -0,0 +1,201 @@
+#ifndef INTEGRAL_HPP
+#define INTEGRAL_HPP
+
+#include "cubic_spline.hpp"
+#include <vector>
+#include <algorithm>
+
+namespace grob{
+
+    namespace _integral_impl{
+        template <typename T>
+        struct is_rect:std::false_type{};
+        template <typename T>
+        struct is_rect<Rect<T>>:std::true_type{};
+
+        /// @brief histogram grids give bins (Rect) by operator[]
+        template <typename GridType>
+        struct is_histo_grid:is_rect<typename std::decay<decltype(std::declval<GridType const &>()[0])>::type>{};
+
+        /// @brief left edge of cell i, for i == number of cells right edge of the last one
+        template <typename GridType>
+        inline auto edge(GridType const & grid,size_t i) noexcept{
+            if constexpr (is_histo_grid<GridType>::value){
+                return (i < grid.size() ? grid[i].left : grid[grid.size()-1].right);
+            } else {
+                return grid[i];
+            }
+        }
+
+        /// @brief number of cells of 1-dim grid: bins of histogram, or intervals between nodes
+        template <typename GridType>
+        inline size_t cells(GridType const & grid) noexcept{
+            return (is_histo_grid<GridType>::value ? grid.size() : grid.size() - 1);
+        }
+
+        template <typename Interpolator>
+        struct is_linear:std::integral_constant<bool,
+                std::is_same<Interpolator,linear_interpolator>::value ||
+                std::is_same<Interpolator,linear_extrapolator>::value ||
+                std::is_same<Interpolator,multilinear_interpolator>::value>{};
+
+        template <typename Interpolator>
+        struct is_cubic_spline:std::integral_constant<bool,
+                std::is_same<Interpolator,interpolator_cubic_spline>::value ||
+                std::is_same<Interpolator,interpolator_cubic_spline_diff>::value>{};
+    };
+
+    /**
+     * \brief cumulative integral of 1-dim piecewise polynomial function (GridFunction or Histogramm), built in O(n).
+     * Row i of Table (5 numbers) is integral from the first edge to left edge of cell i,
+     * and coefficients of integral inside the cell as polynomial of t = x - left edge,
+     * so antiderivative(x) and integral(a,b) need one and two locates respectively.
+     * Integrals are taken over the grid range only: arguments are clamped to it
+    */
+    template <typename GridType,typename V>
+    struct integral_index{
+        typedef typename std::decay<decltype(_integral_impl::edge(std::declval<GridType const &>(),0))>::type X;
+        GridType Grid;
+        std::vector<V> Table;
+
+        integral_index(){}
+        integral_index(GridType Grid,std::vector<V> Table):Grid(std::move(Grid)),Table(std::move(Table)){}
+
+        /**
+         * \brief builds index from polynomials of cells
+         * @param Cell Cell(i,c) fills c[0..3], coefficients of u^k in cell i, u = (x-left)/(right-left)
+        */
+        template <typename CellFunc>
+        integral_index(GridType _Grid,CellFunc && Cell):Grid(std::move(_Grid)){
+            const size_t n = _integral_impl::cells(Grid);
+            Table.resize(5*n);
+            V sum = 0;
+            for(size_t i=0;i<n;++i){
+                V c[4];
+                Cell(i,c);
+                X h = _integral_impl::edge(Grid,i+1) - _integral_impl::edge(Grid,i);
+                V * r = Table.data() + 5*i;
+                r[0] = sum;
+                // int_0^t c_k (s/h)^k ds = c_k t^(k+1)/((k+1) h^k)
+                X hk = 1;
+                for(size_t k=0;k<4;++k){
+                    r[k+1] = c[k]/((k+1)*hk);
+                    hk *= h;
+                }
+                sum += h*(c[0] + c[1]/2 + c[2]/3 + c[3]/4);
+            }
+            Table.push_back(sum);
+        }
+
+        inline size_t size() const noexcept{return Table.size()/5;}
+        inline X lower() const noexcept{return _integral_impl::edge(Grid,0);}
+        inline X upper() const noexcept{return _integral_impl::edge(Grid,size());}
+
+        /// @brief integral from lower() to x
+        inline V antiderivative(X x) const noexcept{
+            x = std::clamp(x,lower(),upper());
+            size_t i = Grid.pos(x);
+            X t = x - _integral_impl::edge(Grid,i);
+            const V * r = Table.data() + 5*i;
+            return r[0] + t*(r[1] + t*(r[2] + t*(r[3] + t*r[4])));
+        }
+
+        /// @brief integral from a to b (negative if b < a)
+        inline V integral(X a,X b) const noexcept{
+            return antiderivative(b) - antiderivative(a);
+        }
+
+        /// @brief integral over all grid
+        inline V total() const noexcept{return Table.back();}
+
+        /**
+         * \brief antiderivative as GridFunction.
+         * For functions: cubic Hermite spline (interpolator_cubic_spline) on the same grid with exact values and
+         * derivatives at nodes, exact for linear interpolation.
+         * For histograms: piecewise linear cumulative sum on bin edges, exact
+        */
+        auto antiderivative_function() const{
+            const size_t n = size();
+            if constexpr (_integral_impl::is_histo_grid<GridType>::value){
+                std::vector<X> edges(n+1);
+                std::vector<V> values(n+1);
+                for(size_t i=0;i<=n;++i){
+                    edges[i] = _integral_impl::edge(Grid,i);
+                    values[i] = Table[5*i];
+                }
+                return make_function<linear_interpolator>(GridVector<X>(std::move(edges)),std::move(values));
+            } else {
+                std::vector<V> values(n+1),coeffs(4*n);
+                for(size_t i=0;i<=n;++i){
+                    values[i] = Table[5*i];
+                }
+                for(size_t i=0;i<n;++i){
+                    const V * r = Table.data() + 5*i;
+                    X h = _integral_impl::edge(Grid,i+1) - _integral_impl::edge(Grid,i);
+                    // derivative of antiderivative at ends of cell is function value
+                    V d0 = r[1],d1 = r[1] + h*(2*r[2] + h*(3*r[3] + h*4*r[4]));
+                    _spline_impl::hermite_cell(coeffs.data() + 4*i,values[i],values[i+1],V(h*d0),V(h*d1));
+                }
+                return GridFunction<interpolator_cubic_spline,typename std::decay<GridType>::type,spline_values<V>>(
+                        Grid,spline_values<V>(std::move(values),std::move(coeffs)));
+            }
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("Grid","Table"),
+                              PROPERTIES(Grid,Table))
+        WRITE_FUNCTION(Grid,Table)
+        DESERIALIZATOR_FUNCTION(integral_index,
+            PROPERTY_NAMES("Grid","Table"),
+            PROPERTY_TYPES(Grid,Table))
+        READ_FUNCTION(integral_index,PROPERTY_TYPES(Grid,Table))
+    };
+
+    /**
+     * \brief integral index of 1-dim GridFunction, exact for linear_interpolator, spline1D
+     * and interpolator_cubic_spline over spline_values (all spline_kind)
+    */
+    template <typename Interpolator,typename GridType,typename ContainerType>
+    auto make_integral_index(GridFunction<Interpolator,GridType,ContainerType> const & F){
+        typedef typename std::decay<GridType>::type Grid_t;
+        static_assert(Grid_t::Dim == 1,"integral index is defined for 1-dim grids");
+        typedef typename std::decay<decltype(F.Values[0])>::type V;
+        const size_t n = F.Grid.size();
+        if constexpr (_integral_impl::is_linear<Interpolator>::value){
+            return integral_index<Grid_t,V>(F.Grid,[&](size_t i,V * c){
+                c[0] = F.Values[i];
+                c[1] = F.Values[i+1] - F.Values[i];
+                c[2] = c[3] = 0;
+            });
+        } else if constexpr (std::is_same<Interpolator,interpolator_spline1D>::value){
+            std::vector<V> values(n),coeffs(4*(n-1));
+            for(size_t i=0;i<n;++i){
+                values[i] = F.Values[i];
+            }
+            _spline_impl::hermite_coeffs(F.Grid,values,coeffs);
+            return integral_index<Grid_t,V>(F.Grid,[&](size_t i,V * c){
+                std::copy(coeffs.data() + 4*i,coeffs.data() + 4*i + 4,c);
+            });
+        } else {
+            static_assert(_integral_impl::is_cubic_spline<Interpolator>::value,
+                "integral index supports linear_interpolator, spline1D and interpolator_cubic_spline");
+            return integral_index<Grid_t,V>(F.Grid,[&](size_t i,V * c){
+                std::copy(F.Values.cell(i),F.Values.cell(i) + 4,c);
+            });
+        }
+    }
+
+    /// @brief integral index of 1-dim Histogramm: contents of bins are spread uniformly over bins
+    template <typename GridType,typename ContainerType,typename ValueSetter>
+    auto make_integral_index(Histogramm<GridType,ContainerType,ValueSetter> const & H){
+        typedef typename std::decay<GridType>::type Grid_t;
+        static_assert(Grid_t::Dim == 1,"integral index is defined for 1-dim grids");
+        static_assert(_integral_impl::is_histo_grid<Grid_t>::value,"expect histogram grid");
+        typedef typename std::decay<decltype(H.Values[0])>::type V;
+        return integral_index<Grid_t,V>(H.Grid,[&](size_t i,V * c){
+            c[0] = H.Values[i]/(_integral_impl::edge(H.Grid,i+1) - _integral_impl::edge(H.Grid,i));
+            c[1] = c[2] = c[3] = 0;
+        });
+    }
+};
+
+#endif//INTEGRAL_HPP
@@ -0,0 +1,134 @@
+#ifndef INVERSE_HPP
+#define INVERSE_HPP
+
+#include "grid_objects.hpp"
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+
+namespace grob{
+
+    namespace _inverse_impl{
+        /// @return true if values of F at nodes are strictly increasing, false if strictly decreasing
+        template <typename FuncType>
+        bool is_increasing(FuncType const & F){
+            const size_t n = F.Grid.size();
+            if(n < 2){
+                throw std::invalid_argument("inverse: grid should have at least 2 nodes");
+            }
+            bool increasing = F.Values[0] < F.Values[1];
+            for(size_t i=0;i+1<n;++i){
+                if(increasing ? !(F.Values[i] < F.Values[i+1]) : !(F.Values[i+1] < F.Values[i])){
+                    throw std::invalid_argument("inverse: function values should be strictly monotone");
+                }
+            }
+            return increasing;
+        }
+
+        /**
+         * \brief solves F(x) = y in cell [a,b], where y is between F(a) = fa and F(b) = fb.
+         * Regula falsi with Illinois modification: the first step is exact for linear segments,
+         * iterations stop when bracket is less than tolerance*(b-a)
+        */
+        template <typename FuncType,typename X,typename Y>
+        X solve_cell(FuncType const & F,X a,X b,Y fa,Y fb,Y const & y,X tolerance){
+            fa -= y;
+            fb -= y;
+            if(fa == 0)
+                return a;
+            if(fb == 0)
+                return b;
+            const X eps = tolerance*(b - a);
+            int side = 0;
+            X x = a;
+            for(size_t iter = 0;iter < 100;++iter){
+                x = (a*fb - b*fa)/(fb - fa);
+                Y fx = F(x) - y;
+                if(fx == 0){
+                    break;
+                }
+                if((fx < 0) == (fa < 0)){
+                    a = x;
+                    fa = fx;
+                    if(side == -1)
+                        fb /= 2;
+                    side = -1;
+                } else {
+                    b = x;
+                    fb = fx;
+                    if(side == 1)
+                        fa /= 2;
+                    side = 1;
+                }
+                if(std::abs(b - a) < eps){
+                    x = (a*fb - b*fa)/(fb - fa);
+                    break;
+                }
+            }
+            return x;
+        }
+    };
+
+    /**
+     * \brief inverse of strictly monotone 1-dim GridFunction F on its own nodes:
+     * grid is F.Values at nodes (GridVector), values are nodes of F, interpolation is linear.
+     * Exact inverse for linear_interpolator F, for other interpolators only node values are exact.
+     * Throws std::invalid_argument if values are not strictly monotone
+    */
+    template <typename FuncType>
+    auto inverse(FuncType const & F){
+        const size_t n = F.Grid.size();
+        const bool increasing = _inverse_impl::is_increasing(F);
+        typedef typename std::decay<decltype(F.Values[0])>::type Y;
+        typedef typename std::decay<decltype(F.Grid[0])>::type X;
+        std::vector<Y> ys(n);
+        std::vector<X> xs(n);
+        for(size_t i=0;i<n;++i){
+            size_t j = (increasing ? i : n - 1 - i);
+            ys[i] = F.Values[j];
+            xs[i] = F.Grid[j];
+        }
+        return make_function<linear_interpolator>(GridVector<Y>(std::move(ys)),std::move(xs));
+    }
+
+    /**
+     * \brief inverse of strictly monotone 1-dim GridFunction F on uniform grid of n_nodes values
+     * from min to max of F.Values, so inverse lookup locates cell in O(1).
+     * Nodes are found in one merge sweep over cells of F, in each cell F(x) = y is solved
+     * up to tolerance (relative to cell width), linear segments are solved exactly.
+     * @tparam Interpolator interpolator of inverse function
+     * Throws std::invalid_argument if values are not strictly monotone or n_nodes < 2
+    */
+    template <typename Interpolator = linear_interpolator,typename FuncType,
+                typename X = typename std::decay<decltype(std::declval<FuncType const &>().Grid[0])>::type>
+    auto inverse(FuncType const & F,size_t n_nodes,X tolerance = X(1e-12)){
+        if(n_nodes < 2){
+            throw std::invalid_argument("inverse: expect at least 2 nodes of inverse function");
+        }
+        const size_t n = F.Grid.size();
+        const bool increasing = _inverse_impl::is_increasing(F);
+        typedef typename std::decay<decltype(F.Values[0])>::type Y;
+        auto node = [&](size_t i){return (increasing ? i : n - 1 - i);};
+
+        GridUniform<Y> YGrid(F.Values[node(0)],F.Values[node(n-1)],n_nodes);
+        std::vector<X> xs(n_nodes);
+        xs.front() = F.Grid[node(0)];
+        xs.back() = F.Grid[node(n-1)];
+        size_t i = 0;
+        for(size_t k=1;k+1<n_nodes;++k){
+            Y y = YGrid[k];
+            while(i + 2 < n && F.Values[node(i+1)] < y){
+                ++i;
+            }
+            size_t l = node(i),r = node(i+1);
+            if(l > r){
+                std::swap(l,r);
+            }
+            xs[k] = _inverse_impl::solve_cell(F,F.Grid[l],F.Grid[r],F.Values[l],F.Values[r],y,tolerance);
+        }
+        return make_function<Interpolator>(std::move(YGrid),std::move(xs));
+    }
+};
+
+#endif//INVERSE_HPP
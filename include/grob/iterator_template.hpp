@@ -147,6 +147,52 @@ namespace grob{
         }
     };
 
+    /// @brief finds last i, that !cmp(x,X[i]), starting from cell i_hint and galloping outward
+    /// @return i: 0 <= i <= X.size()-2, O(log(|i - i_hint|)) comparisons
+    template <typename Container,typename T,typename Comparator = std::less<T>>
+    inline size_t __find_index_sorted_with_hint(const Container &X,T const&x,size_t i_hint,
+                                        Comparator && cmp = std::less<T>{}){
+        size_t N = X.size();
+        if(N <= 1){
+            return 0;
+        }
+        size_t i0 = (i_hint < N - 2 ? i_hint : N - 2);
+        if(cmp(x,X[i0])){
+            size_t di = 1;
+            size_t i1 = i0;
+            while(true){
+                if(di >= i1){
+                    i0 = 0;
+                    break;
+                }
+                i0 = i1 - di;
+                if(!cmp(x,X[i0])){
+                    break;
+                }
+                i1 = i0;
+                di *= 2;
+            }
+            return __find_index_sorted_corrector(X,x,i0,i1,cmp);
+        }
+        else{
+            size_t di = 1;
+            size_t i1;
+            while(true){
+                i1 = i0 + di;
+                if(i1 >= N - 1){
+                    i1 = N - 1;
+                    break;
+                }
+                if(cmp(x,X[i1])){
+                    break;
+                }
+                i0 = i1;
+                di *= 2;
+            }
+            return __find_index_sorted_corrector(X,x,i0,i1,cmp);
+        }
+    }
+
     template <typename Container,typename T,typename Comparator = std::less<T>>
     inline size_t __find_index_sorted_with_guess(const Container &X,T const&x, 
                                         Comparator && cmp = std::less<T>{}){
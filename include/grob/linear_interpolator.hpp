@@ -3,6 +3,9 @@
 
 #include "rectangle.hpp"
 #include "templates.hpp"
+#include "multigrid.hpp"
+#include "rectilinear_grid.hpp"
+#include <array>
 
 namespace grob{
 
@@ -16,6 +19,10 @@ namespace grob{
         constexpr auto is_uniform_grid(self_t<GridUniform<T>>){
             return std::true_type{};
         } 
+        template <typename T,size_t N,typename A,typename B>
+        constexpr auto is_uniform_grid(self_t<GridUniformStatic<T,N,A,B>>){
+            return std::true_type{};
+        }
         template <typename T>
         constexpr auto is_uniform_grid(T){
             return std::false_type{};
@@ -56,90 +63,341 @@ namespace grob{
 
     };
 
-    struct linear_interpolator{
-        template <size_t tuple_shift = 0,typename RectType,typename Tuple>
-        constexpr inline static  auto get_interpolator_coeffs(RectType const & R,Tuple const & X) noexcept{
-            typedef decltype(R.first().interpol_coeff(std::get<tuple_shift>(X))) CoeffType;
-            typename templdefs::tuple_cat<CoeffType,
-                                decltype(get_interpolator_coeffs<tuple_shift+1>(R.inner_reduce(std::declval<CoeffType>()),X))>::type Result;
-            set_interpolator_coeffs(R,X,Result);
-            return Result;
-        }
-
-        template <size_t tuple_shift = 0,typename RectType,typename TupleX,typename TupleCoeff>
-        constexpr inline static  void set_interpolator_coeffs(RectType const & R,TupleX const & X,TupleCoeff & Coeffs) noexcept{
-            auto cf = R.first().interpol_coeff(std::get<tuple_shift>(X));
-            std::get<tuple_shift>(Coeffs) = cf;
-            set_interpolator_coeffs<tuple_shift+1>(R.inner_reduce(cf),X,Coeffs);
-        } 
-        template <size_t tuple_shift = 0,typename T,typename TupleX,typename TupleCoeff>
-        constexpr inline static  void set_interpolator_coeffs(Rect<T> const & R,TupleX const & X,TupleCoeff & Coeffs) noexcept{
-            std::get<tuple_shift>(Coeffs) = R.interpol_coeff(std::get<tuple_shift>(X));
-        } 
+    namespace _multilinear_impl{
+        /// @brief keeps inner grid by pointer if grid.inner(i) gives reference, and by value otherwise
+        using _enumerate_impl::grid_holder;
 
-        template <size_t tuple_shift = 0,typename T,typename Tuple>
-        constexpr inline static auto get_interpolator_coeffs(Rect<T> const &R, Tuple const & x)noexcept{
-            static_assert(std::tuple_size<Tuple>::value != 0,"tuple size of x = 0");
-            return std::make_tuple(R.interpol_coeff(std::get<tuple_shift>(x)));
+        /// @brief grids with the same inner grid for every index (mesh_grids, RectilinearGrid)
+        template <typename GridType>
+        struct is_regular:std::false_type{};
+        template <typename GridType,typename GridContainerType>
+        struct is_regular<MultiGrid<GridType,GridContainerType>>:
+            std::integral_constant<bool,is_const_container<typename std::decay<GridContainerType>::type>::value>{};
+        template <typename...GridTypes>
+        struct is_regular<RectilinearGrid<GridTypes...>>:std::true_type{};
+
+        /// @brief finds cell of 1-dim grid, containing x
+        /// @return weight of right node of cell, i is set to left node, h_inv to inverse cell width
+        template <typename GridType,typename T,typename W>
+        inline auto cell(GridType const & grid,T const & point,size_t & i,W & h_inv) noexcept{
+            using namespace __detail_uniform;
+            // 1-dim Point is unwrapped, functional grids transform only plain numbers
+            typename GridType::value_type const & x = point;
+            i = grid.pos(x);
+            h_inv = select_if_uniform(grid,
+                [&](auto const & grid){return grid.h_inv();},[&](auto const & grid){return 1/(grid[i+1]-grid[i]);});
+            return (x-grid[i])*h_inv;
         }
+        template <typename GridType,typename T>
+        inline auto cell(GridType const & grid,T const & point,size_t & i) noexcept{
+            typename std::decay<decltype(grid[0])>::type h_inv;
+            return cell(grid,point,i,h_inv);
+        }
+
+        /**
+         * \brief one level of descent: each of n cells of level d is split into 2 by coordinate d.
+         * Entries are expanded in place (k -> 2k,2k+1) from the last one, so offsets and weights of
+         * all 2^Dim corners are ready after the last level.
+         * If Shared, all n grids of level are the same grid (all upper levels are regular), so cell is found once.
+         * If grads is not nullptr, (*grads)[e] are derivatives of weights by coordinate e
+        */
+        template <size_t d,bool Shared,typename Holder,size_t n,typename Tuple,typename W,size_t N,
+                    typename Grads = std::nullptr_t>
+        inline void descend(std::array<Holder,n> const & grids,Tuple const & X,
+                            std::array<size_t,N> & offsets,std::array<W,N> & weights,Grads grads = nullptr) noexcept{
+            typedef typename std::decay<decltype(grids[0].get())>::type LevelGrid;
+            constexpr bool with_grads = !std::is_same<Grads,std::nullptr_t>::value;
+            auto const & x = std::get<d>(X);
+            size_t i = 0;
+            W t = 0,h_inv = 0;
+            // expands derivatives of entry k by upper coordinates, and adds derivative by coordinate d
+            auto split_grads = [&](size_t k,W w){
+                if constexpr (with_grads){
+                    for(size_t e=0;e<d;++e){
+                        W g = (*grads)[e][k];
+                        (*grads)[e][2*k] = g*(1-t);
+                        (*grads)[e][2*k+1] = g*t;
+                    }
+                    (*grads)[d][2*k] = -w*h_inv;
+                    (*grads)[d][2*k+1] = w*h_inv;
+                }
+            };
+            if constexpr (LevelGrid::Dim == 1){
+                if constexpr (Shared){
+                    t = cell(grids[0].get(),x,i,h_inv);
+                }
+                for(size_t k=n;k-- > 0;){
+                    if constexpr (!Shared){
+                        t = cell(grids[k].get(),x,i,h_inv);
+                    }
+                    size_t offset = offsets[k] + grids[k].get().LinearIndex(i);
+                    W w = weights[k];
+                    offsets[2*k] = offset;
+                    offsets[2*k+1] = offset + 1;
+                    weights[2*k] = w*(1-t);
+                    weights[2*k+1] = w*t;
+                    split_grads(k,w);
+                }
+            } else {
+                typedef grid_holder<decltype(std::declval<LevelGrid const &>().inner(size_t(0)))> InnerHolder;
+                std::array<InnerHolder,2*n> inner;
+                if constexpr (Shared){
+                    t = cell(grids[0].get().grid(),x,i,h_inv);
+                }
+                for(size_t k=n;k-- > 0;){
+                    auto const & G = grids[k].get();
+                    if constexpr (!Shared){
+                        t = cell(G.grid(),x,i,h_inv);
+                    }
+                    size_t offset = offsets[k];
+                    W w = weights[k];
+                    offsets[2*k] = offset + G.LinearPartialIndex(i);
+                    offsets[2*k+1] = offset + G.LinearPartialIndex(i+1);
+                    weights[2*k] = w*(1-t);
+                    weights[2*k+1] = w*t;
+                    split_grads(k,w);
+                    inner[2*k].set(G.inner(i));
+                    inner[2*k+1].set(G.inner(i+1));
+                }
+                descend<d+1,Shared && is_regular<LevelGrid>::value>(inner,X,offsets,weights,grads);
+            }
+        }
+    };
+
+    namespace _eval_batch_impl{
+        /// @brief number of points, located at once in batch evaluation
+        constexpr size_t chunk = 256;
 
+        template <typename GridType>
+        struct is_uniform:decltype(__detail_uniform::is_uniform_grid(
+                            __detail_uniform::self_t<typename std::decay<GridType>::type>{})){};
 
-        template <size_t tuple_cf_id=0,typename GridType,typename ContainerType,typename IndexType,typename Tuple>
-        constexpr inline static auto _interpolate(GridType const & grid,ContainerType const& Values,size_t v_shift,
-                                            IndexType const& Id,Tuple const & Coeffs) noexcept{
-            auto cf = std::get<tuple_cf_id>(Coeffs);
-            return cf*_interpolate<tuple_cf_id+1>(grid.inner(Id.left()),Values,v_shift+grid.LinearIndex(Id.left()),Id.inner_left(),Coeffs)+
-                    (1-cf)*_interpolate<tuple_cf_id+1>(grid.inner(Id.right()),Values,v_shift+grid.LinearIndex(Id.right()),Id.inner_right(),Coeffs);
+        /// @brief containers, which values are stored in one array in order of linear index
+        template <typename ContainerType>
+        struct is_contiguous:std::false_type{};
+        template <typename T,typename Alloc>
+        struct is_contiguous<std::vector<T,Alloc>>:std::true_type{};
+        template <typename T,size_t N>
+        struct is_contiguous<std::array<T,N>>:std::true_type{};
+        template <typename T>
+        struct is_contiguous<vector_view<T>>:std::true_type{};
+
+        /// @brief prefetches values[idx[k]], ..., values[idx[k] + width - 1]
+        template <size_t width = 2,typename ContainerType>
+        inline void prefetch(ContainerType const & values,const size_t * idx,size_t n) noexcept{
+            if constexpr (is_contiguous<ContainerType>::value){
+                auto base = values.data();
+                for(size_t k=0;k<n;++k){
+                    GROB_PREFETCH(base + idx[k]);
+                    if constexpr (width*sizeof(*base) > 64){
+                        GROB_PREFETCH(base + idx[k] + width - 1);
+                    }
+                }
+            }
         }
-        template <size_t tuple_cf_id=0,typename GridType,typename ContainerType,typename Tuple>
-        constexpr inline static auto _interpolate(GridType const & grid,ContainerType const& Values,size_t v_shift,
-                                            Rect<size_t> const& Id,Tuple const & Coeffs) noexcept{
-            auto cf = std::get<tuple_cf_id>(Coeffs);
-            return cf*Values[v_shift+Id.left]+(1-cf)*Values[v_shift+Id.right];
+
+        /// @brief lo[k] = values[idx[k] + shift], hi[k] = values[idx[k] + shift + 1]
+        template <typename ContainerType,typename V>
+        inline void gather_pairs(ContainerType const & values,const size_t * idx,size_t shift,size_t n,V * lo,V * hi) noexcept{
+            if constexpr (is_contiguous<ContainerType>::value &&
+                    std::is_same<typename std::decay<decltype(*values.data())>::type,V>::value){
+                _simd::gather_pairs(values.data(),idx,shift,n,lo,hi);
+            } else {
+                for(size_t k=0;k<n;++k){
+                    lo[k] = values[idx[k] + shift];
+                    hi[k] = values[idx[k] + shift + 1];
+                }
+            }
         }
 
-        template <typename GridType,typename ContainerType,typename Tuple,typename ElementType>
-        inline constexpr static auto _extrapolate(GridType const & grid,ContainerType const& Values,
-                        Tuple const & X,ElementType const& El) noexcept{
-            auto Cf = get_interpolator_coeffs(std::get<1>(El),X);
-            return _interpolate(grid,Values,0,std::get<0>(El),Cf);
+        /// @brief u[k] = weight of right node of cell idx[k], the same as _multilinear_impl::cell
+        template <typename GridType,typename T,typename W>
+        inline void cell_weights(GridType const & grid,const T * xs,const size_t * idx,size_t n,W * u) noexcept{
+            if constexpr (is_uniform<GridType>::value){
+                auto h_inv = grid.h_inv();
+                for(size_t k=0;k<n;++k){
+                    u[k] = (xs[k] - grid[idx[k]])*h_inv;
+                }
+            } else {
+                for(size_t k=0;k<n;++k){
+                    auto x0 = grid[idx[k]];
+                    auto h_inv = 1/(grid[idx[k]+1] - x0);
+                    u[k] = (xs[k] - x0)*h_inv;
+                }
+            }
         }
-        /*
-        template <typename GridType,typename ContainerType,typename Tuple>
-        inline constexpr static auto interpolate(GridType const & grid,ContainerType const& Values,
-            Tuple const & X) noexcept ->decltype(_extrapolate(grid,Values,X,grid.FindElement(templdefs::tuple_reduce(X)))){
-            auto Element = grid.FindElement(templdefs::tuple_reduce(X));
-            if(!std::get<1>(Element).contains_tuple(X)){
-                return 0;
+
+        /// @brief out[k] = interpolate(grid,values,X[k]) by stencils of N nodes of Interpolator:
+        /// stencils of a chunk of points are found first, then their values are prefetched before summation
+        template <typename Interpolator,size_t N,typename GridType,typename ContainerType,typename Point_t,typename R>
+        inline void stencil_batch(GridType const & grid,ContainerType const & values,
+                                const Point_t * X,size_t n,R * out) noexcept{
+            typedef typename std::decay<decltype(std::get<0>(X[0].as_tuple()))>::type W;
+            constexpr size_t chunk = 32;
+            std::array<size_t,N> offsets[chunk];
+            std::array<W,N> weights[chunk];
+            for(size_t k=0;k<n;k += chunk){
+                size_t m = (n - k < chunk ? n - k : chunk);
+                for(size_t l=0;l<m;++l){
+                    Interpolator::stencil(grid,X[k+l],offsets[l],weights[l]);
+                    if constexpr (is_contiguous<ContainerType>::value){
+                        for(size_t c=0;c<N;c += 2){
+                            GROB_PREFETCH(values.data() + offsets[l][c]);
+                        }
+                    }
+                }
+                for(size_t l=0;l<m;++l){
+                    auto result = weights[l][0]*values[offsets[l][0]];
+                    for(size_t c=1;c<N;++c){
+                        result += weights[l][c]*values[offsets[l][c]];
+                    }
+                    out[k+l] = result;
+                }
             }
-            return _extrapolate(grid,Values,X,grid.FindElement(templdefs::tuple_reduce(X)));
-            
-        }*/
+        }
+    };
+
+    /**
+     * \brief N-dim multilinear interpolation over Grid1, MultiGrid (regular or ragged) and RectilinearGrid.
+     * Cells are found in one descent through dimentions (one pos per dimention for regular grids,
+     * 2^d for ragged), then 2^Dim corner values are summed with product weights.
+     * Outside of grid values are extrapolated linearly from boundary cells
+    */
+    struct multilinear_interpolator{
+        /// @brief number of corners, which are summed for Dim dimentional grid
+        template <typename GridType>
+        static constexpr size_t stencil_size = size_t(1) << std::decay<GridType>::type::Dim;
+
+        /// @brief finds linear indexes and weights of 2^Dim corners of cell, containing point
+        template <typename GridType,typename Point_t,typename W,size_t N>
+        inline static void stencil(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights) noexcept{
+            static_assert(N == stencil_size<GridType>,"expect 2^Dim corners");
+            if constexpr (N == 2){
+                W u = _multilinear_impl::cell(grid,point,offsets[0]);
+                offsets[1] = offsets[0] + 1;
+                weights[0] = 1 - u;
+                weights[1] = u;
+            } else {
+                offsets[0] = 0;
+                weights[0] = 1;
+                std::array<_multilinear_impl::grid_holder<GridType const &>,1> root;
+                root[0].set(grid);
+                _multilinear_impl::descend<0,true>(root,point.as_tuple(),offsets,weights);
+            }
+        }
+
+        /// @brief the same as stencil, grads[d][k] are derivatives of weights[k] by coordinate d
+        template <typename GridType,typename Point_t,typename W,size_t N,size_t Dim>
+        inline static void stencil_grad(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights,
+                                std::array<std::array<W,N>,Dim> & grads) noexcept{
+            static_assert(N == stencil_size<GridType>,"expect 2^Dim corners");
+            if constexpr (N == 2){
+                W h_inv;
+                W u = _multilinear_impl::cell(grid,point,offsets[0],h_inv);
+                offsets[1] = offsets[0] + 1;
+                weights[0] = 1 - u;
+                weights[1] = u;
+                grads[0] = {-h_inv,h_inv};
+            } else {
+                offsets[0] = 0;
+                weights[0] = 1;
+                std::array<_multilinear_impl::grid_holder<GridType const &>,1> root;
+                root[0].set(grid);
+                _multilinear_impl::descend<0,true>(root,point.as_tuple(),offsets,weights,&grads);
+            }
+        }
 
         template <typename GridType,typename ContainerType,typename Point_t>
         inline constexpr static auto interpolate(GridType const & grid,
                                             ContainerType const & values,
                                             Point_t const & point){
-            using namespace __detail_uniform;
-            size_t i = grid.pos(point);
-            auto h_inv = select_if_uniform(grid,
-                [&](auto const & grid){return grid.h_inv();},[&](auto const & grid){return 1/(grid[i+1]-grid[i]);});
-            auto u = (point-grid[i])*h_inv;
-            
-            return u*values[i+1] + (1-u)*values[i];
+            constexpr size_t Dim = std::decay<GridType>::type::Dim;
+            if constexpr (Dim == 1){
+                size_t i;
+                auto u = _multilinear_impl::cell(grid,point,i);
+                return u*values[i+1] + (1-u)*values[i];
+            } else {
+                typedef typename std::decay<decltype(std::get<0>(point.as_tuple()))>::type W;
+                constexpr size_t N = stencil_size<GridType>;
+                std::array<size_t,N> offsets;
+                std::array<W,N> weights;
+                stencil(grid,point,offsets,weights);
+
+                auto result = weights[0]*values[offsets[0]];
+                for(size_t k=1;k<N;++k){
+                    result += weights[k]*values[offsets[k]];
+                }
+                return result;
+            }
+        }
+
+        /**
+         * \brief out[k] = interpolate(grid,values,X[k]) for n points.
+         * 1-dim points are located by grid.pos_batch, then values are gathered and weighted in separate loops.
+         * N-dim stencils of a chunk of points are found first, then their values are prefetched before summation
+        */
+        template <typename GridType,typename ContainerType,typename Point_t,typename R>
+        inline static void interpolate_batch(GridType const & grid,ContainerType const & values,
+                                            const Point_t * X,size_t n,R * out) noexcept{
+            constexpr size_t Dim = std::decay<GridType>::type::Dim;
+            if constexpr (Dim == 1){
+                typedef typename std::decay<decltype(values[0])>::type V;
+                typedef typename std::decay<decltype(grid[0])>::type W;
+                constexpr size_t chunk = _eval_batch_impl::chunk;
+                size_t idx[chunk];
+                W u[chunk];
+                V lo[chunk],hi[chunk];
+                for(size_t k=0;k<n;k += chunk){
+                    size_t m = (n - k < chunk ? n - k : chunk);
+                    grid.pos_batch(X + k,m,idx);
+                    _eval_batch_impl::prefetch(values,idx,m);
+                    _eval_batch_impl::cell_weights(grid,X + k,idx,m,u);
+                    _eval_batch_impl::gather_pairs(values,idx,0,m,lo,hi);
+                    for(size_t l=0;l<m;++l){
+                        out[k+l] = u[l]*hi[l] + (1-u[l])*lo[l];
+                    }
+                }
+            } else {
+                _eval_batch_impl::stencil_batch<multilinear_interpolator,stencil_size<GridType>>(grid,values,X,n,out);
+            }
         }
     };
 
-    struct linear_extrapolator:public linear_interpolator{
-        template <typename GridType,typename ContainerType,typename Tuple>
-        inline constexpr static auto interpolate(GridType const & grid,ContainerType const& Values,
-            Tuple const & X) noexcept ->decltype(_extrapolate(grid,Values,X,grid.FindElement(templdefs::tuple_reduce(X)))){
-            auto Element = grid.FindElement(templdefs::tuple_reduce(X));
-            return _extrapolate(grid,Values,X,grid.FindElement(templdefs::tuple_reduce(X)));
+    /// @brief linear interpolation policy, N-dim grids are interpolated by multilinear_interpolator
+    struct linear_interpolator{
+        template <typename GridType,typename ContainerType,typename Point_t>
+        inline constexpr static auto interpolate(GridType const & grid,
+                                            ContainerType const & values,
+                                            Point_t const & point){
+            return multilinear_interpolator::interpolate(grid,values,point);
+        }
+        template <typename GridType,typename ContainerType,typename Point_t,typename R>
+        inline static void interpolate_batch(GridType const & grid,ContainerType const & values,
+                                            const Point_t * X,size_t n,R * out) noexcept{
+            multilinear_interpolator::interpolate_batch(grid,values,X,n,out);
+        }
+
+        template <typename GridType>
+        static constexpr size_t stencil_size = multilinear_interpolator::stencil_size<GridType>;
 
+        template <typename GridType,typename Point_t,typename W,size_t N>
+        inline static void stencil(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights) noexcept{
+            multilinear_interpolator::stencil(grid,point,offsets,weights);
+        }
+        template <typename GridType,typename Point_t,typename W,size_t N,size_t Dim>
+        inline static void stencil_grad(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights,
+                                std::array<std::array<W,N>,Dim> & grads) noexcept{
+            multilinear_interpolator::stencil_grad(grid,point,offsets,weights,grads);
         }
     };
 
+    /// @brief linear extrapolation outside of grid by boundary cells, the same as linear_interpolator
+    struct linear_extrapolator:public linear_interpolator{};
+
 
     /// @brief cubic interpolation policy
     struct interpolator_spline1D{
@@ -200,6 +458,199 @@ namespace grob{
                 return u1_q*(1+u2)*C_0v + u1_q*u*C_0d + (3-u2)*u_q*C_1v+u1*u_q*C_1d;
             }
         }
+
+        template <typename GridType>
+        static constexpr size_t stencil_size = 4;
+
+        /**
+         * \brief interpolate(grid,values,x) = sum weights[k]*values[offsets[k]] over 4 nodes around cell of x.
+         * Weights are coefficients of values in the same formulas as interpolate (spline is linear in values),
+         * unused nodes near ends of grid have zero weight
+        */
+        template <typename GridType,typename Point_t,typename W>
+        inline static void stencil(GridType const & grid,Point_t const & point,
+                                std::array<size_t,4> & offsets,std::array<W,4> & weights) noexcept{
+            stencil_impl(grid,point,offsets,weights,nullptr);
+        }
+
+        /// @brief the same as stencil, grads[0][k] are derivatives of weights[k] by x
+        template <typename GridType,typename Point_t,typename W>
+        inline static void stencil_grad(GridType const & grid,Point_t const & point,
+                                std::array<size_t,4> & offsets,std::array<W,4> & weights,
+                                std::array<std::array<W,4>,1> & grads) noexcept{
+            stencil_impl(grid,point,offsets,weights,&grads[0]);
+        }
+
+        private:
+        /// @brief weights of stencil and, if dweights is not nullptr, their derivatives by x
+        template <typename GridType,typename Point_t,typename W,typename DW>
+        inline static void stencil_impl(GridType const & grid,Point_t const & point,
+                                std::array<size_t,4> & offsets,std::array<W,4> & weights,DW dweights) noexcept{
+            using namespace __detail_uniform;
+            constexpr bool with_grads = !std::is_same<DW,std::nullptr_t>::value;
+            const size_t size = grid.size();
+            size_t first = 0;
+            if(size == 2){
+                auto h_inv = select_if_uniform(grid,
+                    [&](auto const & grid){return grid.h_inv();},[&](auto const & grid){return 1/(grid[1]-grid[0]);});
+                W u = (point - grid.front())*h_inv;
+                weights = {1-u,u,W(0),W(0)};
+                if constexpr (with_grads){
+                    *dweights = {-h_inv,h_inv,W(0),W(0)};
+                }
+            } else {
+                size_t i = grid.pos(point);
+                auto h_inv = select_if_uniform(grid,
+                    [&](auto const & grid){return grid.h_inv();},[&](auto const & grid){return 1/(grid[i+1]-grid[i]);});
+                auto h = select_if_uniform(grid,
+                    [&](auto const & grid){return grid.h();},[&](auto const & grid){return grid[i+1]-grid[i];});
+                W u = (point-grid[i])*h_inv;
+                // Derivative(j) of interpolate is h*(-a1*values[j-1] + (a1-a2)*values[j] + a2*values[j+1])
+                auto derivative_coeffs = [&](size_t j,W & a1,W & a2){
+                    select_if_uniform(grid,
+                        [&](auto const &){
+                            a1 = a2 = h_inv/2;
+                            return 0;
+                        },
+                        [&](auto const & grid){
+                            auto h1 = grid[j] - grid[j-1];
+                            auto h2 = grid[j+1] - grid[j];
+                            auto q = 1/(h1*h2*(h1+h2));
+                            a1 = h2*h2*q;
+                            a2 = h1*h1*q;
+                            return 0;
+                        }
+                    );
+                };
+                // derivatives by u of the same weights, multiplied by h_inv
+                std::array<W,4> du;
+                W a1,a2;
+                if(i == 0){
+                    W u_1 = u-1;
+                    W c = u*u_1*h;
+                    derivative_coeffs(1,a1,a2);
+                    weights = {u_1*u_1 - c*a1,u*(2-u) + c*(a1-a2),c*a2,W(0)};
+                    if constexpr (with_grads){
+                        W dc = (2*u - 1)*h;
+                        du = {2*u_1 - dc*a1,2 - 2*u + dc*(a1-a2),dc*a2,W(0)};
+                    }
+                } else if(i == size-2){
+                    W u_1 = 1-u;
+                    W c = u*u_1*h;
+                    derivative_coeffs(i,a1,a2);
+                    if constexpr (with_grads){
+                        W dc = (1 - 2*u)*h;
+                        du = {-dc*a1,-2*u + dc*(a1-a2),2*u + dc*a2,W(0)};
+                    }
+                    if(size == 3){
+                        weights = {-c*a1,(1+u)*u_1 + c*(a1-a2),u*u + c*a2,W(0)};
+                    } else {
+                        first = size - 4;
+                        weights = {W(0),-c*a1,(1+u)*u_1 + c*(a1-a2),u*u + c*a2};
+                        if constexpr (with_grads){
+                            du = {W(0),du[0],du[1],du[2]};
+                        }
+                    }
+                } else {
+                    // inner cell: Hermite basis, derivatives by nodes i-1,i,i+1 and i,i+1,i+2
+                    W u_q = u*u;
+                    W u1 = (u-1);
+                    W u1_q = u1*u1;
+                    W u2 = 2*u;
+                    W A = u1_q*(1+u2),B = u1_q*u*h,C = (3-u2)*u_q,E = u1*u_q*h;
+                    W b1,b2;
+                    derivative_coeffs(i,a1,a2);
+                    derivative_coeffs(i+1,b1,b2);
+                    weights = {-B*a1,A + B*(a1-a2) - E*b1,C + B*a2 + E*(b1-b2),E*b2};
+                    if constexpr (with_grads){
+                        W dA = 6*u*u1,dB = u1*(3*u - 1)*h,dE = u*(3*u - 2)*h;
+                        du = {-dB*a1,dA + dB*(a1-a2) - dE*b1,-dA + dB*a2 + dE*(b1-b2),dE*b2};
+                    }
+                    first = i - 1;
+                }
+                if constexpr (with_grads){
+                    for(size_t k=0;k<4;++k){
+                        (*dweights)[k] = du[k]*h_inv;
+                    }
+                }
+            }
+            for(size_t k=0;k<4;++k){
+                offsets[k] = (first + k < size ? first + k : size - 1);
+            }
+        }
+
+        public:
+        /**
+         * \brief out[k] = interpolate(grid,values,xs[k]) for n points of 1-dim grid.
+         * Points are located by grid.pos_batch, 4 values of stencil [i-1,i+2] are gathered
+         * and inner cells are evaluated in branchless loop, boundary cells are recomputed by interpolate
+        */
+        template <typename GridType,typename ContainerType,typename T,typename R>
+        inline static void interpolate_batch(GridType const & grid,ContainerType const & values,
+                                            const T * xs,size_t n,R * out) noexcept{
+            static_assert(std::decay<GridType>::type::Dim == 1,"spline1D batch is implemented for 1-dim grids");
+            const size_t size = grid.size();
+            if(size < 4){
+                for(size_t k=0;k<n;++k){
+                    out[k] = interpolate(grid,values,xs[k]);
+                }
+                return;
+            }
+            typedef typename std::decay<decltype(values[0])>::type V;
+            typedef typename std::decay<decltype(grid[0])>::type W;
+            constexpr size_t chunk = _eval_batch_impl::chunk;
+            size_t idx[chunk],left[chunk];
+            W u[chunk];
+            V v0[chunk],v1[chunk],v2[chunk],v3[chunk];
+            for(size_t k=0;k<n;k += chunk){
+                size_t m = (n - k < chunk ? n - k : chunk);
+                grid.pos_batch(xs + k,m,idx);
+                for(size_t l=0;l<m;++l){
+                    // boundary cells are clamped to valid stencil and fixed after
+                    left[l] = (idx[l] < 1 ? 1 : (idx[l] > size - 3 ? size - 3 : idx[l])) - 1;
+                }
+                _eval_batch_impl::prefetch<4>(values,left,m);
+                _eval_batch_impl::cell_weights(grid,xs + k,idx,m,u);
+                _eval_batch_impl::gather_pairs(values,left,0,m,v0,v1);
+                _eval_batch_impl::gather_pairs(values,left,2,m,v2,v3);
+                R * res = out + k;
+                if constexpr (_eval_batch_impl::is_uniform<GridType>::value){
+                    for(size_t l=0;l<m;++l){
+                        auto C_0d = (v2[l] - v0[l])/2;
+                        auto C_1d = (v3[l] - v1[l])/2;
+                        auto u_q = u[l]*u[l];
+                        auto u1 = (u[l]-1);
+                        auto u1_q = u1*u1;
+                        auto u2 = 2*u[l];
+                        res[l] = u1_q*(1+u2)*v1[l] + u1_q*u[l]*C_0d + (3-u2)*u_q*v2[l]+u1*u_q*C_1d;
+                    }
+                } else {
+                    for(size_t l=0;l<m;++l){
+                        size_t i = left[l];
+                        auto g0 = grid[i],g1 = grid[i+1],g2 = grid[i+2],g3 = grid[i+3];
+                        auto h = g2 - g1;
+                        auto derivative = [h](auto h1,auto h2,auto const & vm,auto const & v,auto const & vp){
+                            auto q = 1/(h1*h2*(h1+h2));
+                            auto a1 = h2*h2*q;
+                            auto a2 = h1*h1*q;
+                            return h*(-a1*vm+a2*vp + (a1-a2)*v);
+                        };
+                        auto C_0d = derivative(g1 - g0,h,v0[l],v1[l],v2[l]);
+                        auto C_1d = derivative(h,g3 - g2,v1[l],v2[l],v3[l]);
+                        auto u_q = u[l]*u[l];
+                        auto u1 = (u[l]-1);
+                        auto u1_q = u1*u1;
+                        auto u2 = 2*u[l];
+                        res[l] = u1_q*(1+u2)*v1[l] + u1_q*u[l]*C_0d + (3-u2)*u_q*v2[l]+u1*u_q*C_1d;
+                    }
+                }
+                for(size_t l=0;l<m;++l){
+                    if(idx[l] == 0 || idx[l] == size - 2){
+                        res[l] = interpolate(grid,values,xs[k+l]);
+                    }
+                }
+            }
+        }
     };
     
 
@@ -290,31 +741,262 @@ namespace grob{
                         static_cast<const GridUniform<typename GridType::hidden_value_type> &>(_grid.hidden()),
                         values,_grid.to_hidden(point));
                 },[&](auto const & _grid){
-                    return Interpolator::interpolate(grid,values,point);
+                    return Interpolator::interpolate(_grid,values,point);
                 });
         }
     };
 
+    template <typename InterpolatorX,typename InterpolatorY>
+    struct interpolator_product;
+
+    namespace _stencil_impl{
+        template <typename Interpolator,typename GridType,typename = void>
+        struct stencil_traits{
+            constexpr static bool value = false;
+            constexpr static size_t size = 0;
+        };
+        /// @brief interpolators with static stencil_size<GridType> and stencil(grid,point,offsets,weights)
+        template <typename Interpolator,typename GridType>
+        struct stencil_traits<Interpolator,GridType,
+                    std::void_t<decltype(Interpolator::template stencil_size<GridType>)>>{
+            constexpr static bool value = true;
+            constexpr static size_t size = Interpolator::template stencil_size<GridType>;
+        };
+
+        /// @brief type of first coordinate of point (number or Point)
+        template <typename Point_t,typename = void>
+        struct coord_type{
+            typedef Point_t type;
+        };
+        template <typename Point_t>
+        struct coord_type<Point_t,std::void_t<decltype(std::declval<Point_t const &>().template x<0>())>>{
+            typedef typename std::decay<decltype(std::declval<Point_t const &>().template x<0>())>::type type;
+        };
+
+        template <typename GridType>
+        using outer_grid_t = typename std::decay<decltype(std::declval<GridType const &>().grid())>::type;
+        template <typename GridType>
+        using inner_grid_t = typename std::decay<decltype(std::declval<GridType const &>().inner(size_t(0)))>::type;
+
+        template <typename Interpolator>
+        struct is_product:std::false_type{};
+        template <typename InterpolatorX,typename InterpolatorY>
+        struct is_product<interpolator_product<InterpolatorX,InterpolatorY>>:std::true_type{};
+
+        /// @brief product has stencil if both interpolators have
+        template <typename InterpolatorX,typename InterpolatorY,typename GridType>
+        struct stencil_traits<interpolator_product<InterpolatorX,InterpolatorY>,GridType,
+                    std::void_t<outer_grid_t<GridType>,inner_grid_t<GridType>>>{
+            typedef stencil_traits<InterpolatorX,outer_grid_t<GridType>> tX;
+            typedef stencil_traits<InterpolatorY,inner_grid_t<GridType>> tY;
+            constexpr static bool value = tX::value && tY::value;
+            constexpr static size_t size = tX::size*tY::size;
+        };
+    };
+
+    /**
+     * \brief tensor product of 1-dim InterpolatorX by first coordinate and InterpolatorY by others.
+     * If both have stencils (linear_interpolator, spline1D, products of them) the product stencil is summed:
+     * only outer nodes of X stencil are visited, and inner stencil is found once if all inner grids are the same.
+     * If only InterpolatorX has stencil, InterpolatorY is called for nodes of X stencil
+    */
     template <typename InterpolatorX,typename InterpolatorY>
     struct interpolator_product{
+        template <typename GridType,typename Point_t,typename W,size_t N>
+        inline static void stencil(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights) noexcept{
+            typedef _stencil_impl::stencil_traits<interpolator_product,GridType> traits;
+            constexpr size_t SX = traits::tX::size;
+            constexpr size_t SY = traits::tY::size;
+            static_assert(N == SX*SY,"wrong stencil size");
+            std::array<size_t,SX> oX;
+            std::array<W,SX> wX;
+            InterpolatorX::stencil(grid.grid(),point.template x<0>(),oX,wX);
+            auto tail = point.tail();
+            std::array<size_t,SY> oY;
+            std::array<W,SY> wY;
+            for(size_t a=0;a<SX;++a){
+                if(a == 0 || !_multilinear_impl::is_regular<GridType>::value){
+                    InterpolatorY::stencil(grid.inner(oX[a]),tail,oY,wY);
+                }
+                size_t base = grid.LinearPartialIndex(oX[a]);
+                for(size_t b=0;b<SY;++b){
+                    offsets[a*SY + b] = base + oY[b];
+                    weights[a*SY + b] = wX[a]*wY[b];
+                }
+            }
+        }
+
+        /// @brief the same as stencil, grads[d][k] are derivatives of weights[k] by coordinate d
+        template <typename GridType,typename Point_t,typename W,size_t N,size_t Dim>
+        inline static void stencil_grad(GridType const & grid,Point_t const & point,
+                                std::array<size_t,N> & offsets,std::array<W,N> & weights,
+                                std::array<std::array<W,N>,Dim> & grads) noexcept{
+            typedef _stencil_impl::stencil_traits<interpolator_product,GridType> traits;
+            constexpr size_t SX = traits::tX::size;
+            constexpr size_t SY = traits::tY::size;
+            static_assert(N == SX*SY,"wrong stencil size");
+            std::array<size_t,SX> oX;
+            std::array<W,SX> wX;
+            std::array<std::array<W,SX>,1> dX;
+            InterpolatorX::stencil_grad(grid.grid(),point.template x<0>(),oX,wX,dX);
+            auto tail = point.tail();
+            std::array<size_t,SY> oY;
+            std::array<W,SY> wY;
+            std::array<std::array<W,SY>,Dim-1> dY;
+            for(size_t a=0;a<SX;++a){
+                if(a == 0 || !_multilinear_impl::is_regular<GridType>::value){
+                    InterpolatorY::stencil_grad(grid.inner(oX[a]),tail,oY,wY,dY);
+                }
+                size_t base = grid.LinearPartialIndex(oX[a]);
+                for(size_t b=0;b<SY;++b){
+                    offsets[a*SY + b] = base + oY[b];
+                    weights[a*SY + b] = wX[a]*wY[b];
+                    grads[0][a*SY + b] = dX[0][a]*wY[b];
+                    for(size_t e=1;e<Dim;++e){
+                        grads[e][a*SY + b] = wX[a]*dY[e-1][b];
+                    }
+                }
+            }
+        }
+
         template <typename GridType,typename ContainerType,typename Point_t>
         inline constexpr static auto interpolate(GridType const & grid,
                                             ContainerType const & values,
                                             Point_t const & point)
         {
-            auto MetaContainerFunction = [&](auto const & Index0){
-                return InterpolatorY::interpolate(
-                    grid.inner(Index0),
-                    make_slice(values, grid.LinearIndex({ Index0,0 }), grid.inner(Index0).size()),
-                    point.tail()
+            typedef _stencil_impl::stencil_traits<interpolator_product,GridType> traits;
+            typedef typename std::decay<decltype(point.template x<0>())>::type W;
+            if constexpr (traits::value){
+                return stencil_sum(grid,values,point);
+            } else if constexpr (_stencil_impl::stencil_traits<InterpolatorX,_stencil_impl::outer_grid_t<GridType>>::value){
+                constexpr size_t SX = traits::tX::size;
+                std::array<size_t,SX> oX;
+                std::array<W,SX> wX;
+                InterpolatorX::stencil(grid.grid(),point.template x<0>(),oX,wX);
+                auto tail = point.tail();
+                auto inner_value = [&](size_t i){
+                    return InterpolatorY::interpolate(
+                        grid.inner(i),
+                        make_slice(values, grid.LinearPartialIndex(i), grid.inner(i).size()),
+                        tail
+                    );
+                };
+                auto result = wX[0]*inner_value(oX[0]);
+                for(size_t a=1;a<SX;++a){
+                    result += wX[a]*inner_value(oX[a]);
+                }
+                return result;
+            } else {
+                auto MetaContainerFunction = [&](auto const & Index0){
+                    return InterpolatorY::interpolate(
+                        grid.inner(Index0),
+                        make_slice(values, grid.LinearPartialIndex(Index0), grid.inner(Index0).size()),
+                        point.tail()
+                    );
+                };
+                return InterpolatorX::interpolate(
+                    grid.grid(),
+                    as_container(MetaContainerFunction,grid.grid().size()),
+                    point.template x<0>()
                 );
+            }
+        }
+
+        /**
+         * \brief sum of product stencil by values: values of outer node oX[a] are read through
+         * make_slice(values,...) of its inner grid, nested products are summed the same way,
+         * so containers with own slices (laid_out_vector) find storage position once per 1-dim row.
+         * Inner stencil of last level is found once if grid is regular
+        */
+        template <typename GridType,typename ContainerType,typename Point_t>
+        inline static auto stencil_sum(GridType const & grid,ContainerType const & values,Point_t const & point){
+            typedef _stencil_impl::stencil_traits<interpolator_product,GridType> traits;
+            typedef typename std::decay<decltype(point.template x<0>())>::type W;
+            constexpr size_t SX = traits::tX::size;
+            constexpr size_t SY = traits::tY::size;
+            std::array<size_t,SX> oX;
+            std::array<W,SX> wX;
+            InterpolatorX::stencil(grid.grid(),point.template x<0>(),oX,wX);
+            auto tail = point.tail();
+            std::array<size_t,SY> oY;
+            std::array<W,SY> wY;
+            auto row_sum = [&](size_t a){
+                decltype(auto) inner = grid.inner(oX[a]);
+                auto row = make_slice(values,grid.LinearPartialIndex(oX[a]),inner.size());
+                if constexpr (_stencil_impl::is_product<InterpolatorY>::value){
+                    return InterpolatorY::stencil_sum(inner,row,tail);
+                } else {
+                    if(a == 0 || !_multilinear_impl::is_regular<GridType>::value){
+                        InterpolatorY::stencil(inner,tail,oY,wY);
+                    }
+                    auto result = wY[0]*row[oY[0]];
+                    for(size_t b=1;b<SY;++b){
+                        result += wY[b]*row[oY[b]];
+                    }
+                    return result;
+                }
             };
-            return InterpolatorX::interpolate(
-                grid.grid(),
-                as_container(MetaContainerFunction,grid.grid().size()),
-                point.template x<0>()
-            );
+            auto result = wX[0]*row_sum(0);
+            for(size_t a=1;a<SX;++a){
+                result += wX[a]*row_sum(a);
+            }
+            return result;
+        }
+
+        /// @brief batch evaluation by stencils, if both interpolators have them
+        template <typename GridType,typename ContainerType,typename Point_t,typename R>
+        inline static auto interpolate_batch(GridType const & grid,ContainerType const & values,
+                                            const Point_t * X,size_t n,R * out) noexcept
+            ->typename std::enable_if<_stencil_impl::stencil_traits<interpolator_product,GridType>::value>::type
+        {
+            _eval_batch_impl::stencil_batch<interpolator_product,
+                _stencil_impl::stencil_traits<interpolator_product,GridType>::size>(grid,values,X,n,out);
+        }
+    };
 
+    /**
+     * \brief interpolation policy, evaluating pair(value, gradient) of Interpolator in one pass:
+     * stencil of Interpolator is found with derivatives of its weights by every coordinate,
+     * gradient is Point of Dim components. Interpolator should have stencil_grad
+     * (linear_interpolator, multilinear_interpolator, spline1D and their interpolator_product)
+    */
+    template <typename Interpolator>
+    struct interpolator_grad{
+        template <typename GridType,typename ContainerType,typename Point_t>
+        inline static auto interpolate(GridType const & grid,
+                                    ContainerType const & values,
+                                    Point_t const & point)
+        {
+            typedef _stencil_impl::stencil_traits<Interpolator,GridType> traits;
+            static_assert(traits::value,"interpolator_grad expects interpolator with stencil");
+            constexpr size_t Dim = std::decay<GridType>::type::Dim;
+            constexpr size_t N = traits::size;
+            typedef typename _stencil_impl::coord_type<Point_t>::type W;
+            std::array<size_t,N> offsets;
+            std::array<W,N> weights;
+            std::array<std::array<W,N>,Dim> grads;
+            if constexpr (Dim == 1){
+                typename GridType::value_type const & x = point;
+                Interpolator::stencil_grad(grid,x,offsets,weights,grads);
+            } else {
+                Interpolator::stencil_grad(grid,point,offsets,weights,grads);
+            }
+            typedef typename std::decay<decltype(weights[0]*values[0])>::type V;
+            V value = weights[0]*values[offsets[0]];
+            std::array<V,Dim> grad;
+            for(size_t e=0;e<Dim;++e){
+                grad[e] = grads[e][0]*values[offsets[0]];
+            }
+            for(size_t k=1;k<N;++k){
+                auto const & v = values[offsets[k]];
+                value += weights[k]*v;
+                for(size_t e=0;e<Dim;++e){
+                    grad[e] += grads[e][k]*v;
+                }
+            }
+            return std::make_pair(value,
+                std::apply([](auto const &...g){return make_point(g...);},grad));
         }
     };
 
@@ -326,6 +1008,44 @@ namespace grob{
 
     template <typename InterpolatorX,typename InterpolatorY>
     using interProd = interpolator_product<InterpolatorX,InterpolatorY>;
+
+    template <typename Interpolator>
+    using interGrad = interpolator_grad<Interpolator>;
+
+    /// @brief 3-dim tensor product interpolation
+    template <typename InterpolatorX,typename InterpolatorY,typename InterpolatorZ>
+    using interProd3 = interpolator_product<InterpolatorX,interpolator_product<InterpolatorY,InterpolatorZ>>;
+
+    namespace _eval_batch_impl{
+        struct not_batchable{};
+
+        template <typename Interpolator,typename GridType,typename ContainerType,typename Point_t>
+        auto interpolate_batch_check(Interpolator *,GridType const & grid,ContainerType const & values,Point_t const * X)
+            ->decltype(Interpolator::interpolate_batch(grid,values,X,0,
+                (typename std::decay<decltype(Interpolator::interpolate(grid,values,*X))>::type *)nullptr));
+        not_batchable interpolate_batch_check(...);
+
+        /// @brief checks if Interpolator has static interpolate_batch(grid,values,X,n,out)
+        template <typename Interpolator,typename GridType,typename ContainerType,typename Point_t>
+        struct has_interpolate_batch: templdefs::is_not_same<not_batchable,
+                    decltype(
+                        interpolate_batch_check(std::declval<Interpolator *>(),std::declval<GridType const &>(),
+                            std::declval<ContainerType const &>(),std::declval<Point_t const *>())
+                    )>{};
+
+        /// @brief calls Interpolator::interpolate_batch if exists, otherwise loops over Interpolator::interpolate
+        template <typename Interpolator,typename GridType,typename ContainerType,typename Point_t,typename R>
+        inline void interpolate_batch(GridType const & grid,ContainerType const & values,
+                                    const Point_t * X,size_t n,R * out){
+            if constexpr (has_interpolate_batch<Interpolator,GridType,ContainerType,Point_t>::value){
+                Interpolator::interpolate_batch(grid,values,X,n,out);
+            } else {
+                for(size_t k=0;k<n;++k){
+                    out[k] = Interpolator::interpolate(grid,values,X[k]);
+                }
+            }
+        }
+    };
 };
 
 #endif
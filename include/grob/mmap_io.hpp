@@ -0,0 +1,435 @@
+#ifndef MMAP_IO_HPP
+#define MMAP_IO_HPP
+
+#include "grid_objects.hpp"
+#include "container_shift.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define GROB_MMAP_POSIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace grob{
+
+/**
+ * \brief binary layout for zero-copy loading of grids, grid functions and histograms
+ * file: file_header, then blocks in order of object traversal (grid axes, then Values),
+ * every block is block_header followed by raw array, both aligned to mmap_io::alignment.
+ * Loaded objects hold vector_view's into mapped file, so loading does not copy arrays.
+*/
+namespace mmap_io{
+    constexpr uint32_t version = 1;
+    constexpr size_t alignment = 64;
+    constexpr uint32_t byte_order_tag = 0x01020304;
+    constexpr char magic[8] = {'G','R','O','B','M','M','A','P'};
+
+    enum class block_kind : uint32_t{
+        uniform = 1,    ///< (a,b) of uniform axis, param is size of axis
+        nodes = 2,      ///< nodes of axis
+        packed_nodes = 3,   ///< nodes of all inner grids of MultiGrid
+        packed_offsets = 4, ///< offsets of inner grids in packed_nodes, param is number of inner grids
+        values = 5      ///< Values of grid object
+    };
+
+    struct file_header{
+        char magic[8];
+        uint32_t version;
+        uint32_t byte_order;
+        uint32_t alignment;
+        uint32_t size_t_size;
+        char reserved[40];
+    };
+    struct block_header{
+        uint32_t kind;
+        uint32_t type_tag;
+        uint64_t elem_size;
+        uint64_t count;
+        uint64_t param;
+        char reserved[32];
+    };
+    static_assert(sizeof(file_header) == alignment && sizeof(block_header) == alignment,
+        "mmap_io headers should be exactly one alignment unit");
+
+    /// @brief 'f' for floating point, 'i' for signed and 'u' for unsigned integers, 'b' for other
+    template <typename T>
+    constexpr uint32_t type_tag() noexcept{
+        return std::is_floating_point<T>::value ? 'f' :
+            (std::is_integral<T>::value ? (std::is_signed<T>::value ? 'i' : 'u') : 'b');
+    }
+
+    /// @brief read-only mapping of whole file, unmapped in destructor
+    /// on non-POSIX platforms file is read into aligned buffer
+    class mapped_file{
+        const char * _data = nullptr;
+        size_t _size = 0;
+#ifndef GROB_MMAP_POSIX
+        std::unique_ptr<char[]> _buffer;
+#endif
+        public:
+        explicit mapped_file(std::string const & path){
+#ifdef GROB_MMAP_POSIX
+            int fd = ::open(path.c_str(),O_RDONLY);
+            if(fd < 0)
+                throw std::runtime_error("mmap_io: can't open file " + path);
+            struct stat st;
+            if(::fstat(fd,&st) != 0 || st.st_size == 0){
+                ::close(fd);
+                throw std::runtime_error("mmap_io: empty or unreadable file " + path);
+            }
+            _size = static_cast<size_t>(st.st_size);
+            void * ptr = ::mmap(nullptr,_size,PROT_READ,MAP_SHARED,fd,0);
+            ::close(fd);
+            if(ptr == MAP_FAILED)
+                throw std::runtime_error("mmap_io: mmap failed for " + path);
+            _data = static_cast<const char *>(ptr);
+#else
+            std::ifstream f(path,std::ios::binary | std::ios::ate);
+            if(!f)
+                throw std::runtime_error("mmap_io: can't open file " + path);
+            _size = static_cast<size_t>(f.tellg());
+            _buffer.reset(new char[_size + alignment]);
+            char * ptr = _buffer.get() + (alignment - reinterpret_cast<uintptr_t>(_buffer.get()) % alignment) % alignment;
+            f.seekg(0);
+            f.read(ptr,_size);
+            _data = ptr;
+#endif
+        }
+        mapped_file(mapped_file const &) = delete;
+        mapped_file & operator = (mapped_file const &) = delete;
+        ~mapped_file(){
+#ifdef GROB_MMAP_POSIX
+            if(_data)
+                ::munmap(const_cast<char *>(_data),_size);
+#endif
+        }
+
+        inline const char * data() const noexcept{return _data;}
+        inline size_t size() const noexcept{return _size;}
+    };
+
+    /// @brief loaded object together with mapping it views into
+    template <typename ObjectType>
+    struct mapped{
+        std::shared_ptr<const mapped_file> File;
+        ObjectType Object;
+
+        inline ObjectType const & get() const noexcept{return Object;}
+        inline ObjectType const & operator *() const noexcept{return Object;}
+        inline ObjectType const * operator ->() const noexcept{return &Object;}
+
+        template <typename...Args>
+        inline auto operator()(Args const&...args) const noexcept{
+            return Object(args...);
+        }
+    };
+
+    /// @brief writes headers and aligned blocks into stream, throws std::runtime_error if stream fails
+    class writer{
+        std::ostream & os;
+        size_t pos = 0;
+
+        inline void raw(const void * data,size_t bytes){
+            if(!os.write(static_cast<const char *>(data),bytes))
+                throw std::runtime_error("mmap_io: write failed");
+            pos += bytes;
+        }
+        public:
+        inline writer(std::ostream & os):os(os){
+            file_header h{};
+            std::memcpy(h.magic,magic,sizeof(magic));
+            h.version = version;
+            h.byte_order = byte_order_tag;
+            h.alignment = alignment;
+            h.size_t_size = sizeof(size_t);
+            raw(&h,sizeof(h));
+        }
+
+        /// @brief starts block of count elements of T, data is written by write_data
+        template <typename T>
+        inline void begin_block(block_kind kind,size_t count,uint64_t param = 0){
+            static_assert(std::is_trivially_copyable<T>::value,"mmap_io: elements should be trivially copyable");
+            block_header h{};
+            h.kind = static_cast<uint32_t>(kind);
+            h.type_tag = type_tag<T>();
+            h.elem_size = sizeof(T);
+            h.count = count;
+            h.param = param;
+            raw(&h,sizeof(h));
+        }
+        template <typename T>
+        inline void write_data(const T * data,size_t count){
+            raw(data,count*sizeof(T));
+        }
+        inline void end_block(){
+            static const char zeros[alignment] = {};
+            if(pos % alignment)
+                raw(zeros,alignment - pos % alignment);
+        }
+        template <typename T>
+        inline void block(block_kind kind,const T * data,size_t count,uint64_t param = 0){
+            begin_block<T>(kind,count,param);
+            write_data(data,count);
+            end_block();
+        }
+    };
+
+    /// @brief checks headers and gives views on blocks of mapped file
+    class reader{
+        const char * _data;
+        size_t _size;
+        size_t pos = 0;
+        public:
+        inline reader(mapped_file const & F):_data(F.data()),_size(F.size()){
+            file_header h;
+            if(_size < sizeof(h))
+                throw std::runtime_error("mmap_io: file is too small");
+            std::memcpy(&h,_data,sizeof(h));
+            if(std::memcmp(h.magic,magic,sizeof(magic)) != 0)
+                throw std::runtime_error("mmap_io: not a grob mapped file");
+            if(h.version != version)
+                throw std::runtime_error("mmap_io: unsupported version " + std::to_string(h.version));
+            if(h.byte_order != byte_order_tag || h.size_t_size != sizeof(size_t))
+                throw std::runtime_error("mmap_io: file is written on incompatible platform");
+            if(h.alignment != alignment)
+                throw std::runtime_error("mmap_io: unsupported alignment");
+            pos = sizeof(h);
+        }
+
+        /// @brief view on next block, which should be of kind and of elements T
+        /// @param param optional output of block parameter
+        template <typename T>
+        inline vector_view<const T> block(block_kind kind,uint64_t * param = nullptr){
+            block_header h;
+            if(pos > _size || _size - pos < sizeof(h))
+                throw std::runtime_error("mmap_io: unexpected end of file");
+            std::memcpy(&h,_data + pos,sizeof(h));
+            pos += sizeof(h);
+            if(h.kind != static_cast<uint32_t>(kind))
+                throw std::runtime_error("mmap_io: layout mismatch, expected block kind " +
+                    std::to_string(static_cast<uint32_t>(kind)) + ", got " + std::to_string(h.kind));
+            if(h.type_tag != type_tag<T>() || h.elem_size != sizeof(T))
+                throw std::runtime_error("mmap_io: element type mismatch");
+            // count is read from file: compare without multiplication to avoid wrap around
+            if(h.count > (_size - pos)/sizeof(T))
+                throw std::runtime_error("mmap_io: unexpected end of file");
+            size_t bytes = h.count*sizeof(T);
+            const T * ptr = reinterpret_cast<const T *>(_data + pos);
+            pos += (bytes + alignment - 1)/alignment*alignment;
+            if(param)
+                *param = h.param;
+            return vector_view<const T>(ptr,h.count);
+        }
+    };
+
+    namespace _mmap_impl{
+        template <typename ContainerType>
+        struct container_io{
+            static_assert(!std::is_same<ContainerType,ContainerType>::value,
+                "mmap_io: grid container is not supported, use uniform or node based grids");
+        };
+
+        template <typename T>
+        struct container_io<UniformContainer<T>>{
+            typedef UniformContainer<T> view_type;
+            static void save(writer & w,UniformContainer<T> const & C){
+                T ab[2] = {C[0],C[C.size()-1]};
+                w.block(block_kind::uniform,ab,2,C.size());
+            }
+            static view_type load(reader & r){
+                uint64_t size;
+                auto ab = r.block<T>(block_kind::uniform,&size);
+                return view_type(ab[0],ab[1],size);
+            }
+        };
+
+        template <typename T>
+        struct nodes_io{
+            typedef vector_view<const T> view_type;
+            template <typename ContainerType>
+            static void save(writer & w,ContainerType const & C){
+                w.block(block_kind::nodes,C.data(),C.size());
+            }
+            static view_type load(reader & r){
+                return r.block<T>(block_kind::nodes);
+            }
+        };
+        template <typename T,typename...Args>
+        struct container_io<std::vector<T,Args...>>:nodes_io<T>{};
+        template <typename T,size_t N>
+        struct container_io<std::array<T,N>>:nodes_io<T>{};
+        template <typename T>
+        struct container_io<vector_view<T>>:nodes_io<typename std::decay<T>::type>{};
+
+        template <typename ContainerType>
+        struct container_io<numerical_histo_container<ContainerType>>{
+            typedef numerical_histo_container<typename container_io<ContainerType>::view_type> view_type;
+            static void save(writer & w,numerical_histo_container<ContainerType> const & C){
+                container_io<ContainerType>::save(w,C.unhisto());
+            }
+            static view_type load(reader & r){
+                return view_type(container_io<ContainerType>::load(r));
+            }
+        };
+
+        template <typename ObjectType>
+        struct object_io{
+            static_assert(!std::is_same<ObjectType,ObjectType>::value,
+                "mmap_io: object is not supported");
+        };
+
+        template <typename ContainerType,typename Helper>
+        struct object_io<Grid1<ContainerType,Helper>>{
+            typedef container_io<ContainerType> cio;
+            typedef Grid1<typename cio::view_type,Helper> view_type;
+            static void save(writer & w,Grid1<ContainerType,Helper> const & G){
+                cio::save(w,G.container());
+            }
+            static view_type load(reader & r){
+                return view_type(cio::load(r));
+            }
+        };
+
+        /// @brief nodes of 1-dim grid, for histogram grids the edges of bins
+        template <typename ContainerType>
+        inline decltype(auto) raw_nodes(ContainerType const & C){return C;}
+        template <typename ContainerType>
+        inline decltype(auto) raw_nodes(numerical_histo_container<ContainerType> const & C){return C.unhisto();}
+
+        /// @brief 2-dim MultiGrid, inner grids are stored packed and loaded as PackedGridsView
+        template <typename GridType,typename GridContainerType>
+        struct object_io<MultiGrid<GridType,GridContainerType>>{
+            typedef MultiGrid<GridType,GridContainerType> object_type;
+            typedef typename object_type::InnerGridType inner_type;
+            typedef typename object_io<typename std::decay<GridType>::type>::view_type grid_view_type;
+            typedef typename object_io<inner_type>::view_type inner_view_type;
+            typedef typename inner_view_type::container_t::value_type T;
+            typedef MultiGrid<grid_view_type,PackedGridsView<inner_view_type>> view_type;
+
+            static_assert(object_type::Dim == 2,"mmap_io: only 2-dim MultiGrid is supported");
+            static_assert(std::is_same<
+                typename std::decay<decltype(raw_nodes(std::declval<typename inner_view_type::container_t>()))>::type,
+                vector_view<const T>>::value,
+                "mmap_io: inner grids of MultiGrid should be node based");
+
+            static void save(writer & w,object_type const & G){
+                object_io<typename std::decay<GridType>::type>::save(w,G.grid());
+                auto const & InnerGrids = G.inner();
+                size_t n = InnerGrids.size();
+                std::vector<size_t> Offsets(n + 1,0);
+                for(size_t i=0;i<n;++i){
+                    // inner grid may be returned by value (e.g. PackedGrids)
+                    decltype(auto) inner = InnerGrids[i];
+                    Offsets[i+1] = Offsets[i] + raw_nodes(inner.container()).size();
+                }
+                w.begin_block<T>(block_kind::packed_nodes,Offsets[n]);
+                for(size_t i=0;i<n;++i){
+                    decltype(auto) inner = InnerGrids[i];
+                    auto const & nodes = raw_nodes(inner.container());
+                    w.write_data(nodes.data(),nodes.size());
+                }
+                w.end_block();
+                w.block(block_kind::packed_offsets,Offsets.data(),Offsets.size(),n);
+            }
+            static view_type load(reader & r){
+                auto Grid = object_io<typename std::decay<GridType>::type>::load(r);
+                auto Nodes = r.block<T>(block_kind::packed_nodes);
+                uint64_t n;
+                auto Offsets = r.block<size_t>(block_kind::packed_offsets,&n);
+                if(Offsets.size() != n + 1 || (n && Offsets[n] != Nodes.size()))
+                    throw std::runtime_error("mmap_io: inconsistent packed offsets");
+                return view_type(std::move(Grid),PackedGridsView<inner_view_type>(Nodes,Offsets));
+            }
+        };
+
+        template <typename ContainerType>
+        inline void save_values(writer & w,ContainerType const & Values){
+            w.block(block_kind::values,Values.data(),Values.size());
+        }
+
+        template <typename Interpolator,typename GridType,typename ContainerType>
+        struct object_io<GridFunction<Interpolator,GridType,ContainerType>>{
+            typedef typename std::decay<decltype(std::declval<ContainerType>()[0])>::type T;
+            typedef object_io<typename std::decay<GridType>::type> gio;
+            typedef GridFunction<Interpolator,typename gio::view_type,vector_view<const T>> view_type;
+            static void save(writer & w,GridFunction<Interpolator,GridType,ContainerType> const & F){
+                gio::save(w,F.Grid);
+                save_values(w,F.Values);
+            }
+            static view_type load(reader & r){
+                auto Grid = gio::load(r);
+                auto Values = r.block<T>(block_kind::values);
+                if(Values.size() != Grid.size())
+                    throw std::runtime_error("mmap_io: size of Values doesn't match grid");
+                return view_type(std::move(Grid),Values);
+            }
+        };
+
+        template <typename GridType,typename ContainerType,typename ValueSetter>
+        struct object_io<Histogramm<GridType,ContainerType,ValueSetter>>{
+            typedef typename std::decay<decltype(std::declval<ContainerType>()[0])>::type T;
+            typedef object_io<typename std::decay<GridType>::type> gio;
+            typedef Histogramm<typename gio::view_type,vector_view<const T>,ValueSetter> view_type;
+            static void save(writer & w,Histogramm<GridType,ContainerType,ValueSetter> const & H){
+                gio::save(w,H.Grid);
+                save_values(w,H.Values);
+            }
+            static view_type load(reader & r){
+                auto Grid = gio::load(r);
+                auto Values = r.block<T>(block_kind::values);
+                if(Values.size() != Grid.size())
+                    throw std::runtime_error("mmap_io: size of Values doesn't match grid");
+                return view_type(std::move(Grid),Values);
+            }
+        };
+    };
+
+    /// @brief type of object, loaded from file, saved from ObjectType
+    template <typename ObjectType>
+    using view_type = typename _mmap_impl::object_io<typename std::decay<ObjectType>::type>::view_type;
+
+    /// @brief writes grid, grid function or histogram to stream in mmap_io layout
+    template <typename ObjectType>
+    inline void save(std::ostream & os,ObjectType const & Object){
+        writer w(os);
+        _mmap_impl::object_io<ObjectType>::save(w,Object);
+        if(!os.flush())
+            throw std::runtime_error("mmap_io: write failed");
+    }
+    /// @brief writes grid, grid function or histogram to file in mmap_io layout
+    /// file, which is mapped, should not be rewritten in place (write new file and rename it)
+    template <typename ObjectType>
+    inline void save(std::string const & path,ObjectType const & Object){
+        std::ofstream f(path,std::ios::binary);
+        if(!f)
+            throw std::runtime_error("mmap_io: can't open file " + path);
+        save(f,Object);
+        f.close();
+        if(!f)
+            throw std::runtime_error("mmap_io: write failed for " + path);
+    }
+
+    /// @brief maps file, written by save(path,ObjectType), arrays of returned object are views into mapping
+    /// @tparam ObjectType type of saved object
+    /// @return mapped<view_type<ObjectType>>, mapping lives while any copy of it alive
+    template <typename ObjectType>
+    inline mapped<view_type<ObjectType>> load(std::string const & path){
+        auto File = std::make_shared<const mapped_file>(path);
+        reader r(*File);
+        auto Object = _mmap_impl::object_io<typename std::decay<ObjectType>::type>::load(r);
+        return mapped<view_type<ObjectType>>{std::move(File),std::move(Object)};
+    }
+};
+
+};
+
+#endif//MMAP_IO_HPP
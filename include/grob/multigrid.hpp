@@ -205,6 +205,34 @@ namespace grob{
     }
 
 
+    namespace _batch_impl{
+        struct not_rows_batchable{};
+
+        template <typename ContainerType,typename T>
+        auto rows_pos_batch_check(ContainerType const & C,T const * ys)
+            ->decltype(C.pos_batch((const size_t *)nullptr,ys,0,(size_t *)nullptr));
+        not_rows_batchable rows_pos_batch_check(...);
+
+        /// @brief checks if container of inner grids has pos_batch(rows,ys,n,out)
+        template <typename ContainerType,typename T>
+        struct has_rows_pos_batch: templdefs::is_not_same<not_rows_batchable,
+                    decltype(
+                        rows_pos_batch_check(std::declval<ContainerType const &>(),std::declval<T const *>())
+                    )>{};
+
+        /// @brief out[k] = C[rows[k]].pos(ys[k]), calls C.pos_batch if exists
+        template <typename ContainerType,typename T>
+        inline void rows_pos_batch(ContainerType const & C,const size_t * rows,const T * ys,size_t n,size_t * out) noexcept{
+            if constexpr (has_rows_pos_batch<ContainerType,T>::value){
+                C.pos_batch(rows,ys,n,out);
+            } else {
+                for(size_t k=0;k<n;++k){
+                    out[k] = C[rows[k]].pos(ys[k]);
+                }
+            }
+        }
+    };
+
     /// @brief Class, implementing multi dimention quad grid (Dim - dimention)
     /// @tparam GridType type of one dimention grid for 1st index
     /// @tparam GridContainerType type of container, containinng (Dim-1) grids
@@ -359,6 +387,35 @@ namespace grob{
                 fill_index_tuple_save_impl<tuple_index+1>(_Tp,index_to_fill.m,b);
         }
 
+        /// @brief checks point and finds its linear index in one descent,
+        /// without building MultiIndex (same as LinearIndex(spos(args...)))
+        /// @return linear index if grid contains point, and nullopt otherwise
+        template <typename...Args>
+        inline std::optional<size_t> locate_linear(Args const&...args) const noexcept{
+            static_assert(sizeof...(Args) == Dim,
+                "Multigrid locate_linear dimentional error");
+            return locate_linear_tuple(std::make_tuple(args...));
+        }
+
+        /// @brief tuple version of locate_linear(args...)
+        template <size_t tuple_index = 0,typename...Args>
+        inline std::optional<size_t> locate_linear_tuple(std::tuple<Args...> const& TX) const noexcept{
+            size_t offset = 0;
+            if(!locate_linear_impl<tuple_index>(TX,offset))
+                return std::nullopt;
+            return offset;
+        }
+
+        template <size_t tuple_index = 0,typename Tuple>
+        inline bool locate_linear_impl(Tuple const & _Tp,size_t & offset) const noexcept{
+            auto const & x = std::get<tuple_index>(_Tp);
+            if(!Grid.contains(x))
+                return false;
+            size_t i = Grid.LinearIndex(Grid.pos(x));
+            offset += Indexes[i];
+            return InnerGrids[i].template locate_linear_impl<tuple_index+1>(_Tp,offset);
+        }
+
         /// @brief MultiIndex matching args... 
         template <typename T,typename...Other>
         inline auto pos(T const & x,Other const&...Y) const noexcept{
@@ -382,7 +439,52 @@ namespace grob{
             return MultiIndexType(i,
                 InnerGrids[Grid.LinearIndex(i)].template pos_tuple<tuple_index+1>(X)
             );
-        }       
+        }
+
+        /// @brief same as pos(x,Y...), but search in every dimention starts from hint
+        /// @param hint expected MultiIndex, e.g. result of previous call
+        template <typename T,typename...Other>
+        inline auto pos_hint(MultiIndexType const & hint,T const & x,Other const&...Y) const noexcept{
+            static_assert(1 + sizeof...(Y) == Dim,
+                "Multigrid pos_hint dimentional error");
+            auto i =  Grid.pos_hint(hint.i,x);
+            return MultiIndexType(i,InnerGrids[Grid.LinearIndex(i)].pos_hint(hint.m,Y...));
+        }
+
+        /// @brief tuple version of pos_hint(hint,args...)
+        template <size_t tuple_index = 0,typename...T>
+        inline  auto pos_hint_tuple(MultiIndexType const & hint,std::tuple<T...> const & X) const noexcept{
+            auto i = Grid.template pos_hint_tuple<tuple_index>(hint.i,X);
+            return MultiIndexType(i,
+                InnerGrids[Grid.LinearIndex(i)].template pos_hint_tuple<tuple_index+1>(hint.m,X)
+            );
+        }
+
+        /// @brief batch pos for 2-dim grids: (out_i[k],out_j[k]) = pos(xs[k],ys[k])
+        /// inner grids are located all at once if InnerGrids has pos_batch(rows,ys,n,out) (e.g. UniformRows)
+        template <typename T,typename U>
+        inline void pos_batch(const T * xs,const U * ys,size_t n,size_t * out_i,size_t * out_j) const noexcept{
+            static_assert(Dim == 2 && std::decay<GridType>::type::Dim == 1,
+                "Multigrid pos_batch is implemented for 2-dim grids");
+            Grid.pos_batch(xs,n,out_i);
+            // for 1-dim Grid LinearIndex(i) == i, so out_i are rows of InnerGrids
+            _batch_impl::rows_pos_batch(InnerGrids,out_i,ys,n,out_j);
+        }
+
+        /// @brief makes cursor, which locates points near previous located
+        inline GridCursor<MultiGrid> cursor() const noexcept{
+            return GridCursor<MultiGrid>(*this);
+        }
+
+        /// @brief view, yielding (MultiIndex, linear index, grid[MultiIndex]) for each point
+        inline GridEnumerator<MultiGrid> enumerate() const noexcept{
+            return GridEnumerator<MultiGrid>(*this);
+        }
+
+        /// @brief k balanced ranges of linear indexes with starting MultiIndex, watch partition_grid
+        inline auto partition(size_t k) const{
+            return partition_grid(*this,k);
+        }
 
         /// @brief gives multidim point or rectangle 
         /// @return 
@@ -412,13 +514,14 @@ namespace grob{
         /// @tparam N 
         /// @param mi 
         /// @return inner(int i) -> InnerGrids[i], inner( (i,j)) -> InnerGrids[i].inner(j) ...
+        /// for containers of views (e.g. PackedGrids) inner grid is returned by value
         template <typename IndexHead,typename...IndexTail> 
-        inline auto const & inner(const MultiIndex<IndexHead,IndexTail...> &mi)const noexcept {
+        inline decltype(auto) inner(const MultiIndex<IndexHead,IndexTail...> &mi)const noexcept {
             return InnerGrids[Grid.LinearIndex(mi.i)].inner(mi.m);
         }
 
         template <typename IndexType> 
-        inline auto const & inner(const  IndexType &i)const noexcept {
+        inline decltype(auto) inner(const  IndexType &i)const noexcept {
             return InnerGrids[Grid.LinearIndex(i)];
         }
 
@@ -491,6 +594,291 @@ namespace grob{
 
     };
 
+    namespace _enumerate_impl{
+        template <typename GridType>
+        struct is_multigrid:std::false_type{};
+        template <typename GridType,typename GridContainerType>
+        struct is_multigrid<MultiGrid<GridType,GridContainerType>>:std::true_type{};
+
+        /// @brief inner grids, given by value, are kept in walker, so they should not have inner walkers
+        /// pointing into them (1-dim inner grids)
+        template <typename GridType>
+        struct is_walkable_multigrid:std::false_type{};
+        template <typename GridType,typename GridContainerType>
+        struct is_walkable_multigrid<MultiGrid<GridType,GridContainerType>>:std::integral_constant<bool,
+            GridType::Dim == 1 && (std::is_reference<decltype(std::declval<MultiGrid<GridType,GridContainerType> const &>().inner(size_t(0)))>::value ||
+            MultiGrid<GridType,GridContainerType>::InnerGridType::Dim == 1)>{};
+
+        /**
+         * \brief walker over MultiGrid: keeps row index of the first grid, its coordinate
+         * and current inner grid, so points are advanced in inner grid and rows are changed only at row end
+        */
+        template <typename GridRef>
+        struct walker<GridRef,typename std::enable_if<is_walkable_multigrid<typename std::decay<GridRef>::type>::value>::type>{
+            typedef typename std::decay<GridRef>::type Grid_t;
+            typedef typename Grid_t::MultiIndexType MultiIndexType;
+            typedef decltype(std::declval<Grid_t const &>().inner(size_t(0))) InnerRef;
+            typedef typename std::decay<decltype(std::declval<Grid_t const &>().grid()[0])>::type X0;
+
+            grid_holder<GridRef> _grid;
+            size_t _i = 0;
+            size_t _n = 0;
+            X0 _x;
+            walker<InnerRef> _inner;
+
+            inline void init(GridRef && grid,MultiIndexType const & mi){
+                _grid.set(std::forward<GridRef>(grid));
+                _i = mi.i;
+                _n = _grid.get().grid().size();
+                if(_i < _n){
+                    _x = _grid.get().grid()[_i];
+                    _inner.init(_grid.get().inner(_i),mi.m);
+                }
+            }
+            inline MultiIndexType index() const noexcept{return MultiIndexType(_i,_inner.index());}
+            inline auto value() const noexcept{return make_point_ht(_x,_inner.value());}
+            inline bool next() noexcept{
+                if(_inner.next()){
+                    return true;
+                }
+                if(++_i < _n){
+                    _x = _grid.get().grid()[_i];
+                    auto && inner = _grid.get().inner(_i);
+                    auto zero = inner.MultiZero();
+                    _inner.init(std::forward<decltype(inner)>(inner),zero);
+                    return true;
+                }
+                return false;
+            }
+        };
+    };
+
+    /**
+     * \brief CSR storage of ragged inner grids:
+     * nodes of all inner grids are stored in one buffer,
+     * i'th inner grid is view on Nodes[Offsets[i]], ... Nodes[Offsets[i+1]-1]
+     * @tparam InnerGridType grid over vector_view, e.g. GridVectorView<T> or GridVectorViewHisto<T>
+     * @tparam NodesContainer,OffsetsContainer storage of nodes and offsets,
+     * std::vector (owning) or vector_view (e.g. into mapped file, see PackedGridsView)
+    */
+    template <typename InnerGridType,
+        typename NodesContainer = std::vector<typename InnerGridType::container_t::value_type>,
+        typename OffsetsContainer = std::vector<size_t>>
+    struct PackedGrids{
+        typedef typename InnerGridType::container_t view_container_t;
+        typedef typename view_container_t::value_type T;
+        typedef InnerGridType value_type;
+
+        NodesContainer Nodes;
+        OffsetsContainer Offsets;
+
+        inline PackedGrids():Offsets(1,0){}
+        inline PackedGrids(NodesContainer Nodes,OffsetsContainer Offsets):
+            Nodes(std::move(Nodes)),Offsets(std::move(Offsets)){}
+
+        inline size_t size() const noexcept{return Offsets.size() - 1;}
+
+        /// @brief i'th inner grid (view, valid while PackedGrids alive and not modified)
+        inline InnerGridType operator[](size_t i) const noexcept{
+            return InnerGridType(view_container_t(vector_view<const T>(
+                Nodes.data() + Offsets[i],Offsets[i+1] - Offsets[i])));
+        }
+        inline InnerGridType front() const noexcept{return (*this)[0];}
+        inline InnerGridType back() const noexcept{return (*this)[size()-1];}
+
+        /// @brief appends inner grid nodes, Container is any sized container of T
+        template <typename Container>
+        inline void push_back(Container const & nodes){
+            for(auto it = std::begin(nodes);it != std::end(nodes);++it){
+                Nodes.push_back(*it);
+            }
+            Offsets.push_back(Nodes.size());
+        }
+        inline void reserve(size_t n_grids,size_t n_nodes){
+            Offsets.reserve(n_grids + 1);
+            Nodes.reserve(n_nodes);
+        }
+
+        friend std::ostream & operator << (std::ostream & os,PackedGrids const & PG){
+            std::ostringstream S;
+            S << "PackedGrids(" << PG.size() << ")[";
+            for(size_t i=0;i<PG.size();++i){
+                if(i)
+                    S << ", ";
+                S << PG[i];
+            }
+            S << "]";
+            return os << S.str();
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("Nodes","Offsets"),
+                              PROPERTIES(Nodes,Offsets))
+        WRITE_FUNCTION(Nodes,Offsets)
+        DESERIALIZATOR_FUNCTION(PackedGrids,
+            PROPERTY_NAMES("Nodes","Offsets"),
+            PROPERTY_TYPES(Nodes,Offsets))
+        READ_FUNCTION(PackedGrids,PROPERTY_TYPES(Nodes,Offsets))
+    };
+
+    template <typename T>
+    using PackedGridVector = PackedGrids<GridVectorView<T>>;
+
+    template <typename T>
+    using PackedGridVectorHisto = PackedGrids<GridVectorViewHisto<T>>;
+
+    /// @brief PackedGrids over not owned nodes and offsets, copies share the storage
+    template <typename InnerGridType>
+    using PackedGridsView = PackedGrids<InnerGridType,
+        vector_view<const typename InnerGridType::container_t::value_type>,vector_view<const size_t>>;
+
+    namespace _index_impl{
+        /// @brief Indexes of PackedGridsView are offsets themselves (shifted by i for histogram rows),
+        /// so creating MultiGrid over view is O(1)
+        template <typename InnerGridType>
+        struct _index_container<PackedGridsView<InnerGridType>>{
+            typedef OffsetsViewIndexer type;
+            constexpr static bool is_noexcept = true;
+
+            static type Create(const PackedGridsView<InnerGridType> & V) noexcept{
+                size_t shift = V.size() ? (V.Offsets[1] - V.Offsets[0]) - V[0].size() : 0;
+                return type(V.Offsets.data(),V.Offsets.size(),shift);
+            }
+            static void Update(const PackedGridsView<InnerGridType> & V,type & Indexes) noexcept{
+                Indexes = Create(V);
+            }
+        };
+    };
+
+    /**
+     * \brief SoA storage of uniform inner grids (rows): arrays a[], b[], h_inv[], size[],
+     * i'th inner grid is GridUniform<T>(a[i],b[i],size[i]).
+     * If all rows have the same size, MultiGrid LinearIndex is O(1) (HybridIndexer)
+    */
+    template <typename T>
+    struct UniformRows{
+        typedef GridUniform<T> value_type;
+
+        std::vector<T> A;
+        std::vector<T> B;
+        std::vector<T> H_inv;
+        std::vector<size_t> Sizes;
+        protected:
+        std::vector<T> Fac;
+        size_t _common_size = 0;
+        size_t _max_size = 0;
+        public:
+
+        inline UniformRows(){}
+        inline UniformRows(std::vector<T> A,std::vector<T> B,std::vector<size_t> Sizes):
+            A(std::move(A)),B(std::move(B)),Sizes(std::move(Sizes)){
+            H_inv.reserve(this->Sizes.size());
+            Fac.reserve(this->Sizes.size());
+            for(size_t i=0;i<this->Sizes.size();++i){
+                add_params(i);
+            }
+        }
+
+        inline size_t size() const noexcept{return Sizes.size();}
+
+        /// @brief i'th inner grid
+        inline GridUniform<T> operator[](size_t i) const noexcept{
+            return GridUniform<T>(UniformContainer<T>(A[i],B[i],Sizes[i],Fac[i],H_inv[i]));
+        }
+        inline GridUniform<T> front() const noexcept{return (*this)[0];}
+        inline GridUniform<T> back() const noexcept{return (*this)[size()-1];}
+
+        /// @brief size of each row if all rows have the same size, 0 otherwise
+        inline size_t common_size() const noexcept{return _common_size;}
+
+        inline void push_back(T a,T b,size_t _size){
+            A.push_back(a);
+            B.push_back(b);
+            Sizes.push_back(_size);
+            add_params(Sizes.size()-1);
+        }
+        inline void push_back(GridUniform<T> const & G){
+            push_back(G.front(),G.back(),G.size());
+        }
+        inline void reserve(size_t n){
+            A.reserve(n);
+            B.reserve(n);
+            H_inv.reserve(n);
+            Fac.reserve(n);
+            Sizes.reserve(n);
+        }
+
+        /// @brief same as (*this)[row].pos(x)
+        template <typename U>
+        inline size_t pos(size_t row,U const & x) const noexcept{
+            return _detail::size_t_cast((x - A[row]) * H_inv[row],Sizes[row] - 2);
+        }
+        /// @brief same as (*this)[row].contains(x)
+        template <typename U>
+        inline bool contains(size_t row,U const & x) const noexcept{
+            return A[row] <= x && x <= B[row];
+        }
+        /// @brief out[k] = (*this)[rows[k]].pos(xs[k]), vectorized with gathers
+        template <typename U>
+        inline void pos_batch(const size_t * rows,const U * xs,size_t n,size_t * out) const noexcept{
+            if(_max_size < (size_t(1) << 31)){
+                _simd::uniform_rows_pos(A.data(),H_inv.data(),Sizes.data(),rows,xs,n,out);
+            } else {
+                _simd::uniform_rows_pos<T,U>(A.data(),H_inv.data(),Sizes.data(),rows,xs,n,out);
+            }
+        }
+
+        friend std::ostream & operator << (std::ostream & os,UniformRows const & UR){
+            std::ostringstream S;
+            S << "UniformRows(" << UR.size() << ")[";
+            for(size_t i=0;i<UR.size();++i){
+                if(i)
+                    S << ", ";
+                S << UR[i];
+            }
+            S << "]";
+            return os << S.str();
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("A","B","Sizes"),
+                              PROPERTIES(A,B,Sizes))
+        WRITE_FUNCTION(A,B,Sizes)
+        DESERIALIZATOR_FUNCTION(UniformRows,
+            PROPERTY_NAMES("A","B","Sizes"),
+            PROPERTY_TYPES(A,B,Sizes))
+        READ_FUNCTION(UniformRows,PROPERTY_TYPES(A,B,Sizes))
+
+        protected:
+        inline void add_params(size_t i){
+            // the same expression as in UniformContainer
+            H_inv.push_back((Sizes[i]-1)/(B[i]-A[i]));
+            Fac.push_back(((T)1)/(Sizes[i]-1));
+            _common_size = (i == 0 ? Sizes[i] : (_common_size == Sizes[i] ? _common_size : 0));
+            _max_size = std::max(_max_size,Sizes[i]);
+        }
+    };
+
+    namespace _index_impl{
+        template <typename T>
+        struct _index_container<UniformRows<T>>{
+            typedef HybridIndexer type;
+            constexpr static bool is_noexcept = false;
+
+            static type Create(const UniformRows<T> & V){
+                if(V.size() && V.common_size()){
+                    return type(V.size()+1,V.common_size());
+                }
+                std::vector<size_t> offsets(V.size()+1,0);
+                for(size_t i=0;i<V.size();++i){
+                    offsets[i+1] = offsets[i] + V.Sizes[i];
+                }
+                return type(std::move(offsets));
+            }
+            static void Update(const UniformRows<T> & V,type & Indexes){
+                Indexes = Create(V);
+            }
+        };
+    };
+
     namespace gtypes{
         template <typename GridType,typename InnerGrid,typename...Alloc>
         struct _inner_container_type{
@@ -553,6 +941,53 @@ namespace grob{
         );
     }
 
+    namespace gtypes{
+        template <typename InnerGridType,typename GridTypeA,typename LambdaInitializerType>
+        inline auto make_packed(GridTypeA && GridA,LambdaInitializerType && LambdaInitializer){
+            PackedGrids<InnerGridType> PG;
+            size_t n = GridA.size();
+            PG.Offsets.reserve(n + 1);
+            for(size_t i=0;i<n;++i){
+                PG.push_back(LambdaInitializer(i));
+            }
+            return make_grid(std::forward<GridTypeA>(GridA),std::move(PG));
+        }
+    };
+
+    /// @brief makes ragged grid with inner grids packed in one buffer (PackedGridVector)
+    /// @param GridA grid1
+    /// @param LambdaInitializer callable instance, LambdaInitializer(int i) -> nodes of i'th inner grid
+    /// (any container of T, e.g. std::vector<T> or GridVector<T>)
+    template <typename GridTypeA, typename LambdaInitializerType>
+    inline auto make_grid_packed(GridTypeA && GridA,LambdaInitializerType && LambdaInitializer){
+        typedef typename std::decay<decltype(*std::begin(LambdaInitializer(std::declval<size_t>())))>::type T;
+        return gtypes::make_packed<GridVectorView<T>>(std::forward<GridTypeA>(GridA),
+            std::forward<LambdaInitializerType>(LambdaInitializer));
+    }
+
+    /// @brief histogram version of make_grid_packed, inner grids are GridVectorViewHisto
+    template <typename GridTypeA, typename LambdaInitializerType>
+    inline auto make_histo_grid_packed(GridTypeA && GridA,LambdaInitializerType && LambdaInitializer){
+        typedef typename std::decay<decltype(*std::begin(LambdaInitializer(std::declval<size_t>())))>::type T;
+        return gtypes::make_packed<GridVectorViewHisto<T>>(std::forward<GridTypeA>(GridA),
+            std::forward<LambdaInitializerType>(LambdaInitializer));
+    }
+
+    /// @brief makes ragged grid with uniform inner grids stored as SoA (UniformRows)
+    /// @param GridA grid1
+    /// @param LambdaInitializer callable instance, LambdaInitializer(int i) -> i'th inner GridUniform
+    template <typename GridTypeA, typename LambdaInitializerType>
+    inline auto make_grid_uniform_rows(GridTypeA && GridA,LambdaInitializerType && LambdaInitializer){
+        typedef typename std::decay<decltype(LambdaInitializer(std::declval<size_t>()))>::type::value_type T;
+        UniformRows<T> UR;
+        size_t n = GridA.size();
+        UR.reserve(n);
+        for(size_t i=0;i<n;++i){
+            UR.push_back(LambdaInitializer(i));
+        }
+        return make_grid(std::forward<GridTypeA>(GridA),std::move(UR));
+    }
+
     /// @brief meshes grids
     /// @param GridA 
     /// @param GridB 
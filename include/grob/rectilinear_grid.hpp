@@ -0,0 +1,287 @@
+#ifndef RECTILINEAR_GRID_HPP
+#define RECTILINEAR_GRID_HPP
+
+#include "grid.hpp"
+#include "point.hpp"
+#include <array>
+#include <tuple>
+#include <optional>
+#include <utility>
+
+namespace grob{
+
+    template <typename GridType,typename...GridTypes>
+    class RectilinearGrid;
+
+    namespace _rectilinear_impl{
+        template <typename GridType,typename...GridTypes>
+        struct inner_type{
+            typedef RectilinearGrid<GridType,GridTypes...> type;
+        };
+        template <typename GridType>
+        struct inner_type<GridType>{
+            typedef GridType type;
+        };
+    };
+
+    /**
+     * \brief dense N-dim grid, product of 1-dim grids G1 x ... x Gn
+     * unlike mesh_grids (MultiGrid<G,ConstValueVector<...>>) index is flat std::array,
+     * LinearIndex is dot product with strides and MultiIncrement is odometer
+     * @tparam GridType,GridTypes 1-dim grids (Grid1)
+    */
+    template <typename GridType,typename...GridTypes>
+    class RectilinearGrid{
+        public:
+        constexpr static size_t Dim = 1 + sizeof...(GridTypes);
+        typedef typename _rectilinear_impl::inner_type<GridTypes...>::type InnerGridType;
+        typedef std::array<size_t,Dim> MultiIndexType;
+        typedef Point<typename GridType::value_type,typename GridTypes::value_type...> value_type;
+
+        static_assert(GridType::Dim == 1 && ((GridTypes::Dim == 1) && ...),
+            "RectilinearGrid: all axes should be 1-dim grids");
+
+        protected:
+        GridType Grid;
+        InnerGridType Inner;
+        std::array<size_t,Dim> Sizes{};
+        std::array<size_t,Dim> Strides{};
+
+        template <size_t...I>
+        inline void init_strides(std::index_sequence<I...>) noexcept{
+            Sizes = {axis<I>().size()...};
+            size_t stride = 1;
+            for(size_t k=Dim;k-- > 0;){
+                Strides[k] = stride;
+                stride *= Sizes[k];
+            }
+        }
+
+        template <size_t tuple_index,typename Tuple,size_t...I>
+        inline MultiIndexType pos_tuple_impl(Tuple const & X,std::index_sequence<I...>) const noexcept{
+            return {axis<I>().pos(std::get<tuple_index + I>(X))...};
+        }
+        template <size_t tuple_index,typename Tuple,size_t...I>
+        inline bool contains_tuple_impl(Tuple const & X,std::index_sequence<I...>) const noexcept{
+            return (axis<I>().contains(std::get<tuple_index + I>(X)) && ...);
+        }
+        template <size_t tuple_index,typename Tuple,size_t...I>
+        inline bool locate_linear_impl(Tuple const & X,size_t & offset,std::index_sequence<I...>) const noexcept{
+            return ((axis<I>().contains(std::get<tuple_index + I>(X)) &&
+                (offset += axis<I>().LinearIndex(axis<I>().pos(std::get<tuple_index + I>(X)))*Strides[I],true)) && ...);
+        }
+        template <size_t...I>
+        inline constexpr size_t linear_index_impl(MultiIndexType const & mi,std::index_sequence<I...>) const noexcept{
+            return ((mi[I]*Strides[I]) + ...);
+        }
+        template <size_t...I>
+        inline auto get_point(MultiIndexType const & mi,std::index_sequence<I...>) const noexcept{
+            return make_point(axis<I>()[mi[I]]...);
+        }
+
+        public:
+        inline RectilinearGrid() noexcept{}
+
+        /// @brief construct from all axes (G1,...,Gn) or from (G1,inner)
+        template <typename...Tail,
+            typename std::enable_if<(sizeof...(Tail) >= 1),bool>::type = true>
+        inline RectilinearGrid(GridType Grid,Tail &&...tail):
+            Grid(std::move(Grid)),Inner(std::forward<Tail>(tail)...){
+            init_strides(std::make_index_sequence<Dim>{});
+        }
+
+        /// @brief k'th axis grid
+        template <size_t k>
+        inline constexpr auto const & axis() const noexcept{
+            static_assert(k < Dim,"RectilinearGrid axis out of range");
+            if constexpr (k == 0)
+                return Grid;
+            else if constexpr (Dim == 2)
+                return Inner;
+            else
+                return Inner.template axis<k-1>();
+        }
+
+        /// @brief full size (linear)
+        inline constexpr size_t size() const noexcept{return Sizes[0]*Strides[0];}
+        inline constexpr MultiIndexType const & sizes() const noexcept{return Sizes;}
+        inline constexpr MultiIndexType const & strides() const noexcept{return Strides;}
+
+        /// @brief grid of first dim
+        inline auto const & grid() const noexcept{return Grid;}
+        /// @brief inner grid, the same for any first index
+        inline auto const & inner() const noexcept{return Inner;}
+        template <typename IndexType>
+        inline auto const & inner(IndexType const &) const noexcept{return Inner;}
+
+        inline constexpr MultiIndexType MultiZero() const noexcept{return MultiIndexType{};}
+
+        inline constexpr bool IsEnd(MultiIndexType const & mi) const noexcept{
+            return mi[0] >= Sizes[0];
+        }
+
+        /// @brief odometer increment, last index is the fastest
+        inline void MultiIncrement(MultiIndexType & mi) const noexcept{
+            for(size_t k=Dim-1;k>0;--k){
+                if(++mi[k] < Sizes[k])
+                    return;
+                mi[k] = 0;
+            }
+            ++mi[0];
+        }
+
+        /// @brief linear position of MultiIndex, sum of mi[k]*stride[k]
+        inline constexpr size_t LinearIndex(MultiIndexType const & mi) const noexcept{
+            return linear_index_impl(mi,std::make_index_sequence<Dim>{});
+        }
+        /// @brief linear position of MultiIndex(i0,0...0)
+        inline constexpr size_t LinearPartialIndex(size_t i0) const noexcept{
+            return i0*Strides[0];
+        }
+
+        inline MultiIndexType FromLinear(size_t i) const noexcept{
+            MultiIndexType mi;
+            for(size_t k=0;k<Dim;++k){
+                mi[k] = i/Strides[k];
+                i -= mi[k]*Strides[k];
+            }
+            return mi;
+        }
+
+        /// @brief check if x1..xn into grid
+        template <typename...Args>
+        inline bool contains(Args const&...args) const noexcept{
+            static_assert(sizeof...(Args) == Dim,"RectilinearGrid contains dimentional error");
+            return contains_tuple(std::make_tuple(args...));
+        }
+        /// @brief same as contains, (x1,...xn) packed into tuple
+        template <size_t tuple_index = 0,typename...Args>
+        inline bool contains_tuple(std::tuple<Args...> const& X) const noexcept{
+            return contains_tuple_impl<tuple_index>(X,std::make_index_sequence<Dim>{});
+        }
+
+        /// @brief MultiIndex matching args...
+        template <typename...Args>
+        inline MultiIndexType pos(Args const&...args) const noexcept{
+            static_assert(sizeof...(Args) == Dim,"RectilinearGrid pos dimentional error");
+            return pos_tuple(std::make_tuple(args...));
+        }
+        /// @brief MultiIndex matching tuple(args...)
+        template <size_t tuple_index = 0,typename...Args>
+        inline MultiIndexType pos_tuple(std::tuple<Args...> const& X) const noexcept{
+            return pos_tuple_impl<tuple_index>(X,std::make_index_sequence<Dim>{});
+        }
+
+        /// @brief check and find MultiIndex matching tuple(args...)
+        /// @return tuple(bool: is_contains,MultiIndex  pos)
+        template <typename...Args>
+        inline auto spos(Args const&...args) const noexcept{
+            return spos_tuple(std::make_tuple(args...));
+        }
+        template <size_t tuple_index = 0,typename...Args>
+        inline auto spos_tuple(std::tuple<Args...> const& X) const noexcept{
+            return std::make_tuple(contains_tuple<tuple_index>(X),pos_tuple<tuple_index>(X));
+        }
+
+        /// @brief checks point and finds its linear index
+        /// @return linear index if grid contains point, and nullopt otherwise
+        template <typename...Args>
+        inline std::optional<size_t> locate_linear(Args const&...args) const noexcept{
+            static_assert(sizeof...(Args) == Dim,"RectilinearGrid locate_linear dimentional error");
+            return locate_linear_tuple(std::make_tuple(args...));
+        }
+        template <size_t tuple_index = 0,typename...Args>
+        inline std::optional<size_t> locate_linear_tuple(std::tuple<Args...> const& X) const noexcept{
+            size_t offset = 0;
+            if(!locate_linear_impl<tuple_index>(X,offset))
+                return std::nullopt;
+            return offset;
+        }
+        template <size_t tuple_index = 0,typename Tuple>
+        inline bool locate_linear_impl(Tuple const & X,size_t & offset) const noexcept{
+            return locate_linear_impl<tuple_index>(X,offset,std::make_index_sequence<Dim>{});
+        }
+
+        /// @brief gives multidim point or rectangle
+        inline auto operator [](MultiIndexType const & mi) const noexcept{
+            return get_point(mi,std::make_index_sequence<Dim>{});
+        }
+
+        /// @brief view, yielding (MultiIndex, linear index, grid[MultiIndex]) for each point
+        inline GridEnumerator<RectilinearGrid> enumerate() const noexcept{
+            return GridEnumerator<RectilinearGrid>(*this);
+        }
+
+        /// @brief k balanced ranges of linear indexes with starting MultiIndex, watch partition_grid
+        inline auto partition(size_t k) const{
+            return partition_grid(*this,k);
+        }
+
+        struct iterator{
+            protected:
+            RectilinearGrid const& __RG;
+            MultiIndexType Position;
+
+            public:
+            inline const auto & index() const{
+                return Position;
+            }
+            inline auto & index(){
+                return Position;
+            }
+            inline operator RectilinearGrid const& ()const{
+                return __RG;
+            }
+
+            iterator(RectilinearGrid const& __RG,MultiIndexType Position):__RG(__RG),Position(Position){}
+            inline iterator & operator ++(){
+                __RG.MultiIncrement(Position);
+                return *this;
+            }
+            inline auto operator *() const{
+                return __RG[Position];
+            }
+
+            template <typename T>
+            inline bool operator !=(T const &)const{
+                return !__RG.IsEnd(Position);
+            }
+        };
+        inline iterator begin() const{
+            return iterator{*this,MultiZero()};
+        }
+        inline iterator end() const{
+            return iterator{*this,MultiZero()};
+        }
+        inline iterator cbegin()const{
+            return begin();
+        }
+        inline iterator cend()const{
+            return end();
+        }
+
+        /// @brief
+        friend std::ostream & operator << (std::ostream & os,const RectilinearGrid &RG){
+            std::ostringstream S;
+            S << "RectilinearGrid(" << RG.Grid << ", " << RG.Inner << ")";
+            return os << S.str();
+        }
+
+        SERIALIZATOR_FUNCTION(PROPERTY_NAMES("Grid","Inner"),
+                              PROPERTIES(Grid,Inner))
+        WRITE_FUNCTION(Grid,Inner)
+        DESERIALIZATOR_FUNCTION(RectilinearGrid,
+            PROPERTY_NAMES("Grid","Inner"),
+            PROPERTY_TYPES(Grid,Inner))
+        READ_FUNCTION(RectilinearGrid,PROPERTY_TYPES(Grid,Inner))
+    };
+
+    /// @brief makes dense grid G1 x ... x Gn with flat index
+    template <typename GridType,typename...GridTypes>
+    inline auto make_rectilinear_grid(GridType && Grid,GridTypes &&...Grids){
+        return RectilinearGrid<typename std::decay<GridType>::type,typename std::decay<GridTypes>::type...>(
+            std::forward<GridType>(Grid),std::forward<GridTypes>(Grids)...);
+    }
+};
+
+#endif//RECTILINEAR_GRID_HPP
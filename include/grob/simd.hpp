@@ -0,0 +1,398 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "iterator_template.hpp"
+#include "container_shift.hpp"
+
+/*!
+    \brief vectorized kernels for batch operations over grids
+    AVX2/AVX-512 paths are selected at compile time (-mavx2, -mavx512f ...),
+    define GROB_NO_SIMD to force scalar code
+*/
+#if !defined(GROB_NO_SIMD) && (SIZE_MAX == UINT64_MAX)
+    #if defined(__AVX512F__)
+        #define GROB_SIMD_AVX512
+    #endif
+    #if defined(__AVX2__)
+        #define GROB_SIMD_AVX2
+    #endif
+#endif
+
+#if defined(GROB_SIMD_AVX2) || defined(GROB_SIMD_AVX512)
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+    #define GROB_PREFETCH(addr) __builtin_prefetch((const void *)(addr))
+#elif defined(_MSC_VER)
+    #include <xmmintrin.h>
+    #define GROB_PREFETCH(addr) _mm_prefetch((const char *)(addr),_MM_HINT_T0)
+#else
+    #define GROB_PREFETCH(addr) ((void)0)
+#endif
+
+namespace grob{
+namespace _simd{
+
+    /// @brief number of lowest set bits of k (k != ~0)
+    inline size_t count_trailing_ones(size_t k) noexcept{
+#if (defined(__GNUC__) || defined(__clang__)) && (SIZE_MAX == UINT64_MAX)
+        return __builtin_ctzll(~(unsigned long long)k);
+#elif (defined(__GNUC__) || defined(__clang__))
+        return __builtin_ctz(~(unsigned int)k);
+#else
+        size_t ret = 0;
+        for(;k & 1;k >>= 1,++ret);
+        return ret;
+#endif
+    }
+
+    /// @brief out[k] = size_t_cast((xs[k]-a)*h_inv,limit), same as uniform_grid_helper::pos_impl
+    template <typename T,typename U>
+    inline void uniform_pos(T a,T h_inv,size_t limit,const U * xs,size_t n,size_t * out) noexcept{
+        for(size_t i=0;i<n;++i){
+            out[i] = _detail::size_t_cast((xs[i] - a) * h_inv, limit);
+        }
+    }
+
+    /// @brief out[k] = __find_index_sorted_with_guess(X,xs[k])
+    template <typename T,typename U>
+    inline void sorted_pos(const T * X,size_t N,const U * xs,size_t n,size_t * out) noexcept{
+        vector_view<const T> V(X,N);
+        for(size_t i=0;i<n;++i){
+            out[i] = __find_index_sorted_with_guess(V,xs[i]);
+        }
+    }
+
+    /// @brief index of x in log-linear binning: (bits(x) >> shift) - first, clamped to [0,limit]
+    /// bits are read as signed integer, so negative x go to 0
+    template <typename T>
+    inline size_t loglinear_index(T x,long long first,unsigned shift,size_t limit) noexcept{
+        typedef typename std::conditional<sizeof(T) == 8,int64_t,int32_t>::type int_t;
+        int_t bits;
+        std::memcpy(&bits,&x,sizeof(T));
+        long long k = static_cast<long long>(bits >> shift) - first;
+        return k <= 0 ? 0 : (static_cast<size_t>(k) < limit ? static_cast<size_t>(k) : limit);
+    }
+
+    template <typename T>
+    inline void loglinear_pos(long long first,unsigned shift,size_t limit,const T * xs,size_t n,size_t * out) noexcept{
+        for(size_t i=0;i<n;++i){
+            out[i] = loglinear_index(xs[i],first,shift,limit);
+        }
+    }
+
+    /// @brief pos in uniform rows: r = rows[k],
+    /// out[k] = size_t_cast((xs[k]-A[r])*H_inv[r],Sizes[r]-2), same as GridUniform(A[r],B[r],Sizes[r]).pos(xs[k])
+    template <typename T,typename U>
+    inline void uniform_rows_pos(const T * A,const T * H_inv,const size_t * Sizes,
+                                const size_t * rows,const U * xs,size_t n,size_t * out) noexcept{
+        for(size_t i=0;i<n;++i){
+            size_t r = rows[i];
+            out[i] = _detail::size_t_cast((xs[i] - A[r]) * H_inv[r], Sizes[r] - 2);
+        }
+    }
+
+    /// @brief lo[k] = base[idx[k] + shift], hi[k] = base[idx[k] + shift + 1]
+    template <typename T>
+    inline void gather_pairs(const T * base,const size_t * idx,size_t shift,size_t n,T * lo,T * hi) noexcept{
+        for(size_t i=0;i<n;++i){
+            lo[i] = base[idx[i] + shift];
+            hi[i] = base[idx[i] + shift + 1];
+        }
+    }
+
+#if defined(GROB_SIMD_AVX2) || defined(GROB_SIMD_AVX512)
+    /*
+        min(v,limit) goes first: for NaN lanes min returns limit,
+        which matches size_t_cast(NaN,limit) == limit
+    */
+    inline void uniform_pos(double a,double h_inv,size_t limit,const double * xs,size_t n,size_t * out) noexcept{
+        size_t i = 0;
+        if(limit < (size_t(1) << 31)){
+#if defined(GROB_SIMD_AVX512)
+            const __m512d va = _mm512_set1_pd(a);
+            const __m512d vh = _mm512_set1_pd(h_inv);
+            const __m512d vlim = _mm512_set1_pd((double)limit);
+            const __m512d vzero = _mm512_setzero_pd();
+            for(;i + 8 <= n;i += 8){
+                __m512d v = _mm512_mul_pd(_mm512_sub_pd(_mm512_loadu_pd(xs + i),va),vh);
+                v = _mm512_max_pd(_mm512_min_pd(v,vlim),vzero);
+                _mm512_storeu_si512((void *)(out + i),_mm512_cvtepi32_epi64(_mm512_cvttpd_epi32(v)));
+            }
+#else
+            const __m256d va = _mm256_set1_pd(a);
+            const __m256d vh = _mm256_set1_pd(h_inv);
+            const __m256d vlim = _mm256_set1_pd((double)limit);
+            const __m256d vzero = _mm256_setzero_pd();
+            for(;i + 4 <= n;i += 4){
+                __m256d v = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(xs + i),va),vh);
+                v = _mm256_max_pd(_mm256_min_pd(v,vlim),vzero);
+                _mm256_storeu_si256((__m256i *)(out + i),_mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(v)));
+            }
+#endif
+        }
+        for(;i<n;++i){
+            out[i] = _detail::size_t_cast((xs[i] - a) * h_inv, limit);
+        }
+    }
+
+    inline void uniform_pos(float a,float h_inv,size_t limit,const float * xs,size_t n,size_t * out) noexcept{
+        size_t i = 0;
+        // limit should be exactly representable as float
+        if(limit < (size_t(1) << 24)){
+#if defined(GROB_SIMD_AVX512)
+            const __m512 va = _mm512_set1_ps(a);
+            const __m512 vh = _mm512_set1_ps(h_inv);
+            const __m512 vlim = _mm512_set1_ps((float)limit);
+            const __m512 vzero = _mm512_setzero_ps();
+            for(;i + 16 <= n;i += 16){
+                __m512 v = _mm512_mul_ps(_mm512_sub_ps(_mm512_loadu_ps(xs + i),va),vh);
+                v = _mm512_max_ps(_mm512_min_ps(v,vlim),vzero);
+                __m512i iv = _mm512_cvttps_epi32(v);
+                _mm512_storeu_si512((void *)(out + i),_mm512_cvtepi32_epi64(_mm512_castsi512_si256(iv)));
+                _mm512_storeu_si512((void *)(out + i + 8),_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(iv,1)));
+            }
+#else
+            const __m256 va = _mm256_set1_ps(a);
+            const __m256 vh = _mm256_set1_ps(h_inv);
+            const __m256 vlim = _mm256_set1_ps((float)limit);
+            const __m256 vzero = _mm256_setzero_ps();
+            for(;i + 8 <= n;i += 8){
+                __m256 v = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(xs + i),va),vh);
+                v = _mm256_max_ps(_mm256_min_ps(v,vlim),vzero);
+                __m256i iv = _mm256_cvttps_epi32(v);
+                _mm256_storeu_si256((__m256i *)(out + i),_mm256_cvtepi32_epi64(_mm256_castsi256_si128(iv)));
+                _mm256_storeu_si256((__m256i *)(out + i + 4),_mm256_cvtepi32_epi64(_mm256_extracti128_si256(iv,1)));
+            }
+#endif
+        }
+        for(;i<n;++i){
+            out[i] = _detail::size_t_cast((xs[i] - a) * h_inv, limit);
+        }
+    }
+
+    /*
+        A[r], H_inv[r] and Sizes[r] are gathered per lane,
+        Sizes (< 2^31) are converted to double by 2^52 magic number
+    */
+    inline void uniform_rows_pos(const double * A,const double * H_inv,const size_t * Sizes,
+                                const size_t * rows,const double * xs,size_t n,size_t * out) noexcept{
+        size_t i = 0;
+        const __m256i vmagic_i = _mm256_set1_epi64x(0x4330000000000000LL);
+        const __m256d vmagic = _mm256_set1_pd(4503599627370496.0 + 2.0);
+        const __m256d vzero = _mm256_setzero_pd();
+        for(;i + 4 <= n;i += 4){
+            __m256i vr = _mm256_loadu_si256((const __m256i *)(rows + i));
+            __m256d va = _mm256_i64gather_pd(A,vr,8);
+            __m256d vh = _mm256_i64gather_pd(H_inv,vr,8);
+            __m256i vs = _mm256_i64gather_epi64((const long long *)Sizes,vr,8);
+            // (double)size - 2
+            __m256d vlim = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(vs,vmagic_i)),vmagic);
+            __m256d v = _mm256_mul_pd(_mm256_sub_pd(_mm256_loadu_pd(xs + i),va),vh);
+            v = _mm256_max_pd(_mm256_min_pd(v,vlim),vzero);
+            _mm256_storeu_si256((__m256i *)(out + i),_mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(v)));
+        }
+        for(;i<n;++i){
+            size_t r = rows[i];
+            out[i] = _detail::size_t_cast((xs[i] - A[r]) * H_inv[r], Sizes[r] - 2);
+        }
+    }
+
+    /*
+        branchless bisection over several queries at once:
+        base moves to middle while !(x < X[middle]), NaN lanes go right.
+        Off nodes this is the last i with X[i] <= x, the same cell as __find_index_sorted_with_guess.
+        At x equal to node the scalar search may return the cell ending or starting at node
+        depending on its guess, so lanes with x == X[base] are recomputed by it
+    */
+    inline void sorted_pos(const double * X,size_t N,const double * xs,size_t n,size_t * out) noexcept{
+        vector_view<const double> V(X,N);
+        size_t i = 0;
+        if(N >= 2){
+#if defined(GROB_SIMD_AVX512)
+            const __m512i vlim = _mm512_set1_epi64((long long)(N-2));
+            for(;i + 8 <= n;i += 8){
+                const __m512d vx = _mm512_loadu_pd(xs + i);
+                __m512i base = _mm512_setzero_si512();
+                for(size_t len = N;len > 1;){
+                    size_t half = len/2;
+                    __m512i mid = _mm512_add_epi64(base,_mm512_set1_epi64((long long)half));
+                    __mmask8 m = _mm512_cmp_pd_mask(vx,_mm512_i64gather_pd(mid,X,8),_CMP_NLT_UQ);
+                    base = _mm512_mask_blend_epi64(m,base,mid);
+                    len -= half;
+                }
+                unsigned on_node = _mm512_cmp_pd_mask(vx,_mm512_i64gather_pd(base,X,8),_CMP_EQ_OQ);
+                _mm512_storeu_si512((void *)(out + i),_mm512_min_epi64(base,vlim));
+                for(size_t l=0;on_node;++l,on_node >>= 1){
+                    if(on_node & 1)
+                        out[i + l] = __find_index_sorted_with_guess(V,xs[i + l]);
+                }
+            }
+#else
+            const __m256i vlim = _mm256_set1_epi64x((long long)(N-2));
+            for(;i + 4 <= n;i += 4){
+                const __m256d vx = _mm256_loadu_pd(xs + i);
+                __m256i base = _mm256_setzero_si256();
+                for(size_t len = N;len > 1;){
+                    size_t half = len/2;
+                    __m256i mid = _mm256_add_epi64(base,_mm256_set1_epi64x((long long)half));
+                    __m256d m = _mm256_cmp_pd(vx,_mm256_i64gather_pd(X,mid,8),_CMP_NLT_UQ);
+                    base = _mm256_blendv_epi8(base,mid,_mm256_castpd_si256(m));
+                    len -= half;
+                }
+                unsigned on_node = _mm256_movemask_pd(_mm256_cmp_pd(vx,_mm256_i64gather_pd(X,base,8),_CMP_EQ_OQ));
+                base = _mm256_blendv_epi8(base,vlim,_mm256_cmpgt_epi64(base,vlim));
+                _mm256_storeu_si256((__m256i *)(out + i),base);
+                for(size_t l=0;on_node;++l,on_node >>= 1){
+                    if(on_node & 1)
+                        out[i + l] = __find_index_sorted_with_guess(V,xs[i + l]);
+                }
+            }
+#endif
+        }
+        for(;i<n;++i){
+            out[i] = __find_index_sorted_with_guess(V,xs[i]);
+        }
+    }
+
+    inline void sorted_pos(const float * X,size_t N,const float * xs,size_t n,size_t * out) noexcept{
+        vector_view<const float> V(X,N);
+        size_t i = 0;
+        if(N >= 2 && N < (size_t(1) << 31)){
+#if defined(GROB_SIMD_AVX512)
+            const __m512i vlim = _mm512_set1_epi32((int)(N-2));
+            for(;i + 16 <= n;i += 16){
+                const __m512 vx = _mm512_loadu_ps(xs + i);
+                __m512i base = _mm512_setzero_si512();
+                for(size_t len = N;len > 1;){
+                    size_t half = len/2;
+                    __m512i mid = _mm512_add_epi32(base,_mm512_set1_epi32((int)half));
+                    __mmask16 m = _mm512_cmp_ps_mask(vx,_mm512_i32gather_ps(mid,X,4),_CMP_NLT_UQ);
+                    base = _mm512_mask_blend_epi32(m,base,mid);
+                    len -= half;
+                }
+                unsigned on_node = _mm512_cmp_ps_mask(vx,_mm512_i32gather_ps(base,X,4),_CMP_EQ_OQ);
+                base = _mm512_min_epi32(base,vlim);
+                _mm512_storeu_si512((void *)(out + i),_mm512_cvtepi32_epi64(_mm512_castsi512_si256(base)));
+                _mm512_storeu_si512((void *)(out + i + 8),_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(base,1)));
+                for(size_t l=0;on_node;++l,on_node >>= 1){
+                    if(on_node & 1)
+                        out[i + l] = __find_index_sorted_with_guess(V,xs[i + l]);
+                }
+            }
+#else
+            const __m256i vlim = _mm256_set1_epi32((int)(N-2));
+            for(;i + 8 <= n;i += 8){
+                const __m256 vx = _mm256_loadu_ps(xs + i);
+                __m256i base = _mm256_setzero_si256();
+                for(size_t len = N;len > 1;){
+                    size_t half = len/2;
+                    __m256i mid = _mm256_add_epi32(base,_mm256_set1_epi32((int)half));
+                    __m256 m = _mm256_cmp_ps(vx,_mm256_i32gather_ps(X,mid,4),_CMP_NLT_UQ);
+                    base = _mm256_blendv_epi8(base,mid,_mm256_castps_si256(m));
+                    len -= half;
+                }
+                unsigned on_node = _mm256_movemask_ps(_mm256_cmp_ps(vx,_mm256_i32gather_ps(X,base,4),_CMP_EQ_OQ));
+                base = _mm256_min_epi32(base,vlim);
+                _mm256_storeu_si256((__m256i *)(out + i),_mm256_cvtepi32_epi64(_mm256_castsi256_si128(base)));
+                _mm256_storeu_si256((__m256i *)(out + i + 4),_mm256_cvtepi32_epi64(_mm256_extracti128_si256(base,1)));
+                for(size_t l=0;on_node;++l,on_node >>= 1){
+                    if(on_node & 1)
+                        out[i + l] = __find_index_sorted_with_guess(V,xs[i + l]);
+                }
+            }
+#endif
+        }
+        for(;i<n;++i){
+            out[i] = __find_index_sorted_with_guess(V,xs[i]);
+        }
+    }
+    inline void loglinear_pos(long long first,unsigned shift,size_t limit,const double * xs,size_t n,size_t * out) noexcept{
+        size_t i = 0;
+        const __m128i cnt = _mm_cvtsi32_si128((int)shift);
+#if defined(GROB_SIMD_AVX512)
+        const __m512i vfirst = _mm512_set1_epi64(first);
+        const __m512i vlim = _mm512_set1_epi64((long long)limit);
+        const __m512i vzero = _mm512_setzero_si512();
+        for(;i + 8 <= n;i += 8){
+            __m512i k = _mm512_sub_epi64(_mm512_sra_epi64(_mm512_loadu_si512((const void *)(xs + i)),cnt),vfirst);
+            _mm512_storeu_si512((void *)(out + i),_mm512_max_epi64(_mm512_min_epi64(k,vlim),vzero));
+        }
+#else
+        const __m256i vfirst = _mm256_set1_epi64x(first);
+        const __m256i vlim = _mm256_set1_epi64x((long long)limit);
+        const __m256i vzero = _mm256_setzero_si256();
+        for(;i + 4 <= n;i += 4){
+            __m256i v = _mm256_loadu_si256((const __m256i *)(xs + i));
+            // no arithmetic 64-bit shift in AVX2: negative x are zeroed explicitly
+            __m256i neg = _mm256_cmpgt_epi64(vzero,v);
+            __m256i k = _mm256_sub_epi64(_mm256_srl_epi64(v,cnt),vfirst);
+            k = _mm256_andnot_si256(_mm256_or_si256(neg,_mm256_cmpgt_epi64(vzero,k)),k);
+            k = _mm256_blendv_epi8(k,vlim,_mm256_cmpgt_epi64(k,vlim));
+            _mm256_storeu_si256((__m256i *)(out + i),k);
+        }
+#endif
+        for(;i<n;++i){
+            out[i] = loglinear_index(xs[i],first,shift,limit);
+        }
+    }
+
+    inline void loglinear_pos(long long first,unsigned shift,size_t limit,const float * xs,size_t n,size_t * out) noexcept{
+        size_t i = 0;
+        if(limit < (size_t(1) << 31)){
+            const __m128i cnt = _mm_cvtsi32_si128((int)shift);
+#if defined(GROB_SIMD_AVX512)
+            const __m512i vfirst = _mm512_set1_epi32((int)first);
+            const __m512i vlim = _mm512_set1_epi32((int)limit);
+            const __m512i vzero = _mm512_setzero_si512();
+            for(;i + 16 <= n;i += 16){
+                __m512i k = _mm512_sub_epi32(_mm512_sra_epi32(_mm512_loadu_si512((const void *)(xs + i)),cnt),vfirst);
+                k = _mm512_max_epi32(_mm512_min_epi32(k,vlim),vzero);
+                _mm512_storeu_si512((void *)(out + i),_mm512_cvtepi32_epi64(_mm512_castsi512_si256(k)));
+                _mm512_storeu_si512((void *)(out + i + 8),_mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(k,1)));
+            }
+#else
+            const __m256i vfirst = _mm256_set1_epi32((int)first);
+            const __m256i vlim = _mm256_set1_epi32((int)limit);
+            const __m256i vzero = _mm256_setzero_si256();
+            for(;i + 8 <= n;i += 8){
+                __m256i k = _mm256_sub_epi32(_mm256_sra_epi32(_mm256_loadu_si256((const __m256i *)(xs + i)),cnt),vfirst);
+                k = _mm256_max_epi32(_mm256_min_epi32(k,vlim),vzero);
+                _mm256_storeu_si256((__m256i *)(out + i),_mm256_cvtepi32_epi64(_mm256_castsi256_si128(k)));
+                _mm256_storeu_si256((__m256i *)(out + i + 4),_mm256_cvtepi32_epi64(_mm256_extracti128_si256(k,1)));
+            }
+#endif
+        }
+        for(;i<n;++i){
+            out[i] = loglinear_index(xs[i],first,shift,limit);
+        }
+    }
+
+    /*
+        4 lanes of neighbour pairs are loaded by two i64 gathers,
+        shift is added to base, so indexes are used as is
+    */
+    inline void gather_pairs(const double * base,const size_t * idx,size_t shift,size_t n,double * lo,double * hi) noexcept{
+        size_t i = 0;
+        base += shift;
+        for(;i + 4 <= n;i += 4){
+            __m256i vi = _mm256_loadu_si256((const __m256i *)(idx + i));
+            _mm256_storeu_pd(lo + i,_mm256_i64gather_pd(base,vi,8));
+            _mm256_storeu_pd(hi + i,_mm256_i64gather_pd(base + 1,vi,8));
+        }
+        for(;i<n;++i){
+            lo[i] = base[idx[i]];
+            hi[i] = base[idx[i] + 1];
+        }
+    }
+#endif
+
+};
+};
+
+#endif//SIMD_HPP
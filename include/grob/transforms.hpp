@@ -0,0 +1,161 @@
+#ifndef TRANSFORMS_HPP
+#define TRANSFORMS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*!
+    \brief built-in monotone transforms for FunctionalContainer
+    functor maps x to hidden coordinate, nested type inverse maps it back.
+    Only forward transform is used in pos(x), so forward is made fast
+    (approximate, but strictly monotone), and inverse is exact inverse of
+    approximation, so nodes and pos(x) stay consistent
+*/
+namespace grob{
+namespace _transform_impl{
+
+    template <typename T>
+    struct float_bits;
+
+    template <>
+    struct float_bits<double>{
+        typedef uint64_t uint_t;
+        constexpr static int mantissa = 52;
+        constexpr static int bias = 1023;
+        constexpr static uint_t mantissa_mask = (uint_t(1) << mantissa) - 1;
+        constexpr static uint_t one = uint_t(bias) << mantissa;
+    };
+
+    template <>
+    struct float_bits<float>{
+        typedef uint32_t uint_t;
+        constexpr static int mantissa = 23;
+        constexpr static int bias = 127;
+        constexpr static uint_t mantissa_mask = (uint_t(1) << mantissa) - 1;
+        constexpr static uint_t one = uint_t(bias) << mantissa;
+    };
+
+    /// @brief coefficient of log2(1+t) ~ t + c*t*(1-t), t in [0,1)
+    template <typename T>
+    constexpr T log2_coeff = T(0.3466);
+
+    /// @brief approximation of log2(x) for normal x > 0, |error| < 0.0077
+    /// exponent bits + t + c*t*(1-t), strictly increasing and continuous
+    template <typename T>
+    inline T log2_approx(T x) noexcept{
+        typedef float_bits<T> fb;
+        typename fb::uint_t u;
+        std::memcpy(&u,&x,sizeof(T));
+        T e = static_cast<T>(static_cast<int>(u >> fb::mantissa) - fb::bias);
+        u = (u & fb::mantissa_mask) | fb::one;
+        T m;
+        std::memcpy(&m,&u,sizeof(T));
+        T t = m - 1;
+        return e + t + log2_coeff<T>*t*(1 - t);
+    }
+
+    /// @brief exact inverse of log2_approx
+    template <typename T>
+    inline T exp2_approx(T y) noexcept{
+        constexpr T c = log2_coeff<T>;
+        T e = std::floor(y);
+        T f = y - e;
+        // root of c*t^2 - (1+c)*t + f = 0 in [0,1), stable form
+        T t = 2*f/((1 + c) + std::sqrt((1 + c)*(1 + c) - 4*c*f));
+        int ie = static_cast<int>(e);
+        if(ie <= -float_bits<T>::bias || ie > float_bits<T>::bias){
+            return std::ldexp(1 + t,ie);
+        }
+        // 2^ie from exponent bits
+        typename float_bits<T>::uint_t u = typename float_bits<T>::uint_t(ie + float_bits<T>::bias) << float_bits<T>::mantissa;
+        T p2;
+        std::memcpy(&p2,&u,sizeof(T));
+        return (1 + t)*p2;
+    }
+
+    /// @brief x^N for N >= 0 by squaring
+    template <int N>
+    struct ipow{
+        template <typename T>
+        static constexpr inline T function(T x) noexcept{
+            return (N % 2 ? x : T(1))*ipow<N/2>::function(x*x);
+        }
+    };
+    template <>
+    struct ipow<0>{
+        template <typename T>
+        static constexpr inline T function(T) noexcept{
+            return T(1);
+        }
+    };
+};
+
+    /// @brief hidden coordinate is approximation of log2(x), x > 0
+    struct LogTransform{
+        template <typename T>
+        inline T operator()(T x) const noexcept{
+            return _transform_impl::log2_approx(x);
+        }
+        struct inverse{
+            template <typename T>
+            inline T operator()(T y) const noexcept{
+                return _transform_impl::exp2_approx(y);
+            }
+        };
+    };
+
+    /// @brief hidden coordinate is sqrt(x), x >= 0
+    struct SqrtTransform{
+        template <typename T>
+        inline T operator()(T x) const noexcept{
+            return std::sqrt(x);
+        }
+        struct inverse{
+            template <typename T>
+            constexpr inline T operator()(T y) const noexcept{
+                return y*y;
+            }
+        };
+    };
+
+    /// @brief hidden coordinate is x^(N/D) for N/D > 0
+    /// integer power computed exactly by multiplications,
+    /// fractional is approximated as exp2_approx(N/D*log2_approx(x)), x > 0
+    template <int N,int D = 1>
+    struct PowTransform{
+        static_assert(N > 0 && D > 0,"PowTransform: power should be positive");
+        template <typename T>
+        inline T operator()(T x) const noexcept{
+            return _transform_impl::exp2_approx(T(N)/T(D)*_transform_impl::log2_approx(x));
+        }
+        struct inverse{
+            template <typename T>
+            inline T operator()(T y) const noexcept{
+                return _transform_impl::exp2_approx(T(D)/T(N)*_transform_impl::log2_approx(y));
+            }
+        };
+    };
+
+    template <int N>
+    struct PowTransform<N,1>{
+        static_assert(N > 0,"PowTransform: power should be positive");
+        template <typename T>
+        constexpr inline T operator()(T x) const noexcept{
+            return _transform_impl::ipow<N>::function(x);
+        }
+        struct inverse{
+            template <typename T>
+            inline T operator()(T y) const noexcept{
+                // odd powers are defined for negative x too
+                return (N % 2 && y < 0) ? -std::pow(-y,T(1)/N) : std::pow(y,T(1)/N);
+            }
+        };
+    };
+
+    template <>
+    struct PowTransform<1,2>:public SqrtTransform{};
+};
+
+#endif//TRANSFORMS_HPP
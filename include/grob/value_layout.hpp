@@ -0,0 +1,360 @@
+#ifndef VALUE_LAYOUT_HPP
+#define VALUE_LAYOUT_HPP
+
+#include "grid_objects.hpp"
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace grob{
+
+    namespace _layout_impl{
+        /// @brief division by runtime constant d via multiplication (Lemire et al.),
+        /// exact for numerators < 2^32, larger use ordinary division
+        struct fast_divider{
+            size_t d = 1;
+            uint64_t M = 0;
+            inline fast_divider(size_t d = 1) noexcept:d(d),M(d > 1 ? UINT64_MAX/d + 1 : 0){}
+
+            inline size_t div(size_t n) const noexcept{
+#if defined(__SIZEOF_INT128__)
+                if(M && n < (size_t(1) << 32))
+                    return static_cast<size_t>((static_cast<unsigned __int128>(M)*n) >> 64);
+#endif
+                return n/d;
+            }
+        };
+
+        /// @brief spreads bits of x, so that bit k goes to bit k*D
+        template <size_t D>
+        inline uint64_t spread_bits(uint64_t x) noexcept;
+
+        template <>
+        inline uint64_t spread_bits<1>(uint64_t x) noexcept{return x;}
+        template <>
+        inline uint64_t spread_bits<2>(uint64_t x) noexcept{
+#if defined(__BMI2__)
+            return _pdep_u64(x,0x5555555555555555ULL);
+#else
+            x &= 0xFFFFFFFFULL;
+            x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+            x = (x | (x << 8))  & 0x00FF00FF00FF00FFULL;
+            x = (x | (x << 4))  & 0x0F0F0F0F0F0F0F0FULL;
+            x = (x | (x << 2))  & 0x3333333333333333ULL;
+            x = (x | (x << 1))  & 0x5555555555555555ULL;
+            return x;
+#endif
+        }
+        template <>
+        inline uint64_t spread_bits<3>(uint64_t x) noexcept{
+#if defined(__BMI2__)
+            return _pdep_u64(x,0x1249249249249249ULL);
+#else
+            x &= 0x1FFFFFULL;
+            x = (x | (x << 32)) & 0x001F00000000FFFFULL;
+            x = (x | (x << 16)) & 0x001F0000FF0000FFULL;
+            x = (x | (x << 8))  & 0x100F00F00F00F00FULL;
+            x = (x | (x << 4))  & 0x10C30C30C30C30C3ULL;
+            x = (x | (x << 2))  & 0x1249249249249249ULL;
+            return x;
+#endif
+        }
+
+        constexpr size_t pow_size(size_t x,size_t n) noexcept{
+            return n ? x*pow_size(x,n-1) : 1;
+        }
+
+        /// @brief row-major shape of D-dim array, converts linear index to MultiIndex
+        template <size_t D>
+        struct shape_base{
+            std::array<size_t,D> Shape;
+            std::array<fast_divider,D> Dividers;
+
+            inline shape_base(std::array<size_t,D> const & Shape = {}) noexcept:Shape(Shape){
+                for(size_t k=0;k<D;++k){
+                    Dividers[k] = fast_divider(Shape[k]);
+                }
+            }
+            /// @brief number of elements
+            inline size_t size() const noexcept{
+                size_t s = 1;
+                for(size_t k=0;k<D;++k){
+                    s *= Shape[k];
+                }
+                return s;
+            }
+            /// @brief row-major linear index -> MultiIndex, last index is the fastest
+            inline std::array<size_t,D> unravel(size_t li) const noexcept{
+                std::array<size_t,D> mi;
+                for(size_t k=D;k-- > 1;){
+                    size_t q = Dividers[k].div(li);
+                    mi[k] = li - q*Shape[k];
+                    li = q;
+                }
+                mi[0] = li;
+                return mi;
+            }
+        };
+    };
+
+    /**
+     * \brief layout policies map row-major linear index of grid point to position in storage,
+     * position of MultiIndex (i_0,...,i_D-1) is row_code(i_0,...,i_D-2) + last_code(i_D-1),
+     * so rows (e.g. slices in interpolator_product) need one unravel per row
+    */
+
+    /// @brief identity layout (the same as plain vector of values)
+    template <size_t D>
+    struct row_major_layout:_layout_impl::shape_base<D>{
+        constexpr static size_t Dim = D;
+        using _layout_impl::shape_base<D>::shape_base;
+
+        inline size_t storage_size() const noexcept{return this->size();}
+        inline size_t row_code(std::array<size_t,D> const & mi) const noexcept{
+            size_t li = 0;
+            for(size_t k=0;k+1<D;++k){
+                li = (li + mi[k])*this->Shape[k+1];
+            }
+            return li;
+        }
+        inline size_t last_code(size_t j) const noexcept{return j;}
+        inline size_t operator()(size_t li) const noexcept{return li;}
+    };
+
+    /**
+     * \brief Z-order (Morton) layout: bits of indexes are interleaved,
+     * so neighbours in all dimensions are close in memory.
+     * Storage is padded up to Morton code of the last point (at most 2^D times larger for odd shapes)
+    */
+    template <size_t D>
+    struct morton_layout:_layout_impl::shape_base<D>{
+        constexpr static size_t Dim = D;
+        static_assert(D >= 1 && D <= 3,"morton_layout is implemented for 1-3 dimentions");
+        using _layout_impl::shape_base<D>::shape_base;
+
+        inline size_t row_code(std::array<size_t,D> const & mi) const noexcept{
+            uint64_t code = 0;
+            for(size_t k=0;k+1<D;++k){
+                code |= _layout_impl::spread_bits<D>(mi[k]) << (D-1-k);
+            }
+            return static_cast<size_t>(code);
+        }
+        inline size_t last_code(size_t j) const noexcept{
+            return static_cast<size_t>(_layout_impl::spread_bits<D>(j));
+        }
+        inline size_t encode(std::array<size_t,D> const & mi) const noexcept{
+            return row_code(mi) + last_code(mi[D-1]);
+        }
+        inline size_t storage_size() const noexcept{
+            if(!this->size())
+                return 0;
+            std::array<size_t,D> last;
+            for(size_t k=0;k<D;++k){
+                last[k] = this->Shape[k]-1;
+            }
+            return encode(last) + 1;
+        }
+        inline size_t operator()(size_t li) const noexcept{return encode(this->unravel(li));}
+    };
+
+    /**
+     * \brief tiled layout: grid is split into tiles Tile x ... x Tile, stored one after another,
+     * tiles and points in tile are in row-major order. Storage is padded to whole tiles.
+     * @tparam Tile side of tile, power of 2
+    */
+    template <size_t D,size_t Tile = 8>
+    struct tiled_layout:_layout_impl::shape_base<D>{
+        constexpr static size_t Dim = D;
+        static_assert(Tile && (Tile & (Tile-1)) == 0,"tile side should be power of 2");
+        constexpr static size_t TileVolume = _layout_impl::pow_size(Tile,D);
+        std::array<size_t,D> Tiles;
+
+        inline tiled_layout(std::array<size_t,D> const & Shape = {}) noexcept:
+            _layout_impl::shape_base<D>(Shape){
+            for(size_t k=0;k<D;++k){
+                Tiles[k] = (Shape[k] + Tile - 1)/Tile;
+            }
+        }
+        inline size_t storage_size() const noexcept{
+            size_t s = 1;
+            for(size_t k=0;k<D;++k){
+                s *= Tiles[k]*Tile;
+            }
+            return s;
+        }
+        inline size_t row_code(std::array<size_t,D> const & mi) const noexcept{
+            size_t tile = 0,inner = 0;
+            for(size_t k=0;k+1<D;++k){
+                tile = (tile + mi[k]/Tile)*Tiles[k+1];
+                inner = (inner + mi[k]%Tile)*Tile;
+            }
+            return tile*TileVolume + inner;
+        }
+        inline size_t last_code(size_t j) const noexcept{
+            return (j/Tile)*TileVolume + j%Tile;
+        }
+        inline size_t encode(std::array<size_t,D> const & mi) const noexcept{
+            return row_code(mi) + last_code(mi[D-1]);
+        }
+        inline size_t operator()(size_t li) const noexcept{return encode(this->unravel(li));}
+    };
+
+    /**
+     * \brief container of values of regular D-dim grid, indexed by row-major linear index
+     * (as Grid.LinearIndex), but stored in order of Layout.
+     * Can be used as ContainerType of GridFunction/Histogramm, see with_layout.
+     * Index computation costs unravel per row slice (and pdep per access for morton_layout with BMI2).
+     * On random point evaluation row-major storage was faster both for tables in cache
+     * and for 1 GiB tables (several times last level cache), see tests/bench_value_layout.cpp
+    */
+    template <typename T,typename Layout>
+    struct laid_out_vector{
+        typedef T value_type;
+        typedef Layout layout_t;
+        std::vector<T> Data;
+        Layout L;
+
+        inline laid_out_vector(){}
+        inline laid_out_vector(Layout L,T const & value = T{}):Data(L.storage_size(),value),L(std::move(L)){}
+
+        inline size_t size() const noexcept{return L.size();}
+        inline T & operator[](size_t i) noexcept{return Data[L(i)];}
+        inline T const & operator[](size_t i) const noexcept{return Data[L(i)];}
+        inline Layout const & layout() const noexcept{return L;}
+
+        friend std::ostream & operator << (std::ostream & os,laid_out_vector const & V){
+            std::ostringstream S;
+            S << "laid_out_vector[";
+            for(size_t i=0;i<V.size();++i){
+                if(i)
+                    S << ", ";
+                S << V[i];
+            }
+            S << "]";
+            return os << S.str();
+        }
+    };
+
+    /// @brief slice of laid_out_vector [base,base+size),
+    /// if slice is part of one row, index is row_code + last_code(i) without unravel
+    template <typename VectorType>
+    struct laid_out_slice{
+        typedef typename std::decay<VectorType>::type::value_type value_type;
+        typedef typename std::decay<VectorType>::type::layout_t layout_t;
+        constexpr static size_t D = layout_t::Dim;
+
+        VectorType & V;
+        size_t base;
+        size_t _size;
+        size_t row = 0;
+        bool in_row;
+
+        inline laid_out_slice(VectorType & V,size_t base,size_t _size) noexcept:V(V),base(base),_size(_size){
+            auto mi = V.L.unravel(base);
+            in_row = (mi[D-1] == 0 && _size <= V.L.Shape[D-1]);
+            if(in_row)
+                row = V.L.row_code(mi);
+        }
+        inline size_t size() const noexcept{return _size;}
+        inline decltype(auto) operator[](size_t i) const noexcept{
+            return in_row ? V.Data[row + V.L.last_code(i)] : V[base + i];
+        }
+        inline decltype(auto) operator[](size_t i) noexcept{
+            return in_row ? V.Data[row + V.L.last_code(i)] : V[base + i];
+        }
+    };
+
+    template <typename T,typename Layout>
+    inline auto make_slice(laid_out_vector<T,Layout> & V,size_t shift,size_t size = 0)noexcept{
+        return laid_out_slice<laid_out_vector<T,Layout>>(V,shift,size);
+    }
+    template <typename T,typename Layout>
+    inline auto make_slice(laid_out_vector<T,Layout> const & V,size_t shift,size_t size = 0)noexcept{
+        return laid_out_slice<const laid_out_vector<T,Layout>>(V,shift,size);
+    }
+    template <typename VectorType>
+    inline auto make_slice(laid_out_slice<VectorType> const & S,size_t shift,size_t size = 0)noexcept{
+        return laid_out_slice<VectorType>(S.V,S.base + shift,size);
+    }
+
+    namespace _layout_impl{
+        template <typename GridType>
+        struct grid_shape;
+
+        template <typename Container,typename Helper>
+        struct grid_shape<Grid1<Container,Helper>>{
+            constexpr static size_t Dim = 1;
+            static std::array<size_t,1> get(Grid1<Container,Helper> const & G){
+                return {G.size()};
+            }
+        };
+        template <typename...GridTypes>
+        struct grid_shape<RectilinearGrid<GridTypes...>>{
+            constexpr static size_t Dim = sizeof...(GridTypes);
+            static std::array<size_t,Dim> get(RectilinearGrid<GridTypes...> const & G){
+                return G.sizes();
+            }
+        };
+        /// @brief MultiGrid should be regular: all inner grids of the same shape
+        template <typename GridType,typename GridContainerType>
+        struct grid_shape<MultiGrid<GridType,GridContainerType>>{
+            typedef MultiGrid<GridType,GridContainerType> MG;
+            typedef grid_shape<typename MG::InnerGridType> inner_shape;
+            constexpr static size_t Dim = 1 + inner_shape::Dim;
+            static std::array<size_t,Dim> get(MG const & G){
+                auto const & InnerGrids = G.inner();
+                auto inner = inner_shape::get(InnerGrids[0]);
+                for(size_t i=1;i<InnerGrids.size();++i){
+                    if(inner_shape::get(InnerGrids[i]) != inner)
+                        throw std::invalid_argument("value layout: grid is not regular, inner grids differ");
+                }
+                std::array<size_t,Dim> S;
+                S[0] = G.grid().size();
+                for(size_t k=1;k<Dim;++k){
+                    S[k] = inner[k-1];
+                }
+                return S;
+            }
+        };
+    };
+
+    /// @brief shape of regular grid (Grid1, RectilinearGrid or MultiGrid with equal inner grids)
+    template <typename GridType>
+    inline auto grid_shape(GridType const & G){
+        return _layout_impl::grid_shape<typename std::decay<GridType>::type>::get(G);
+    }
+
+    /// @brief copy of GridFunction/Histogramm with Values stored in order of Layout,
+    /// operator[], LinearIndex and interpolation give the same results
+    /// @tparam Layout e.g. morton_layout<2>, tiled_layout<3,8>
+    template <typename Layout,typename Interpolator,typename GridType,typename ContainerType>
+    inline auto with_layout(GridFunction<Interpolator,GridType,ContainerType> const & F){
+        static_assert(Layout::Dim == std::decay<GridType>::type::Dim,"layout dimention doesn't match grid");
+        typedef typename GridFunction<Interpolator,GridType,ContainerType>::value_type T;
+        laid_out_vector<T,Layout> Values(Layout(grid_shape(F.Grid)));
+        for(size_t i=0;i<Values.size();++i){
+            Values[i] = F.Values[i];
+        }
+        return GridFunction<Interpolator,typename std::decay<GridType>::type,laid_out_vector<T,Layout>>(
+            F.Grid,std::move(Values));
+    }
+    template <typename Layout,typename GridType,typename ContainerType,typename ValueSetter>
+    inline auto with_layout(Histogramm<GridType,ContainerType,ValueSetter> const & H){
+        static_assert(Layout::Dim == std::decay<GridType>::type::Dim,"layout dimention doesn't match grid");
+        typedef typename Histogramm<GridType,ContainerType,ValueSetter>::value_type T;
+        laid_out_vector<T,Layout> Values(Layout(grid_shape(H.Grid)));
+        for(size_t i=0;i<Values.size();++i){
+            Values[i] = H.Values[i];
+        }
+        return Histogramm<typename std::decay<GridType>::type,laid_out_vector<T,Layout>,ValueSetter>(
+            typename Histogramm<typename std::decay<GridType>::type,laid_out_vector<T,Layout>,ValueSetter>::GOBase(
+                H.Grid,std::move(Values)),H.VS);
+    }
+};
+
+#endif//VALUE_LAYOUT_HPP
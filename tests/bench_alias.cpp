@@ -0,0 +1,49 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/alias_sampler.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <numeric>
+
+/// @brief alias table vs binary search in cumulative sum, 1e6 bins
+int main(){
+    std::mt19937_64 gen(42);
+    const size_t n = 1 << 20;
+    auto HB = grob::make_histo<double>(grob::GridUniformHisto<double>(0,1,1000001));
+    std::uniform_real_distribution<double> dist(0,1);
+    for(auto & v : HB.Values){
+        v = dist(gen);
+    }
+    auto SB = grob::make_alias_sampler(HB);
+    std::vector<double> cdf(HB.Values.size());
+    std::partial_sum(HB.Values.begin(),HB.Values.end(),cdf.begin());
+    std::vector<decltype(SB)::sample_type> outB(n);
+    double s_0 = 0,s_1 = 0,s_2 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<n;++k){
+        size_t i = std::upper_bound(cdf.begin(),cdf.end(),dist(gen)*cdf.back()) - cdf.begin();
+        i = std::min(i,cdf.size() - 1);
+        s_0 += HB.Grid[i].left + dist(gen)*(HB.Grid[i].right - HB.Grid[i].left);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<n;++k){
+        s_1 += SB(gen).second;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    SB.sample_n(gen,outB);
+    for(auto const & [i,x] : outB){
+        s_2 += x;
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    double ns = 1e9/n;
+    std::cout << "1e6 bins: cdf search " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        " ns, alias " << std::chrono::duration<double>(t2-t1).count()*ns <<
+        " ns, alias sample_n " << std::chrono::duration<double>(t3-t2).count()*ns << " ns" << std::endl;
+    TEST(std::abs(s_1 - s_0) < 1e-2*s_0 && std::abs(s_2 - s_0) < 1e-2*s_0,true);
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+template <typename GridType,typename T>
+double bench_ns(GridType const & G,std::vector<T> const & X,size_t & check){
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i=0;i<X.size();++i){
+        check += G.pos(X[i]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/X.size();
+}
+
+/// @brief GridVector vs GridBucket on strongly non-uniform nodes, random points and exact nodes
+int main(){
+    std::mt19937 gen(42);
+
+    const size_t N = 100000;
+    // log spaced nodes and nodes clustered near 0.3
+    std::vector<double> log_nodes(N),cluster_nodes(N);
+    for(size_t i=0;i<N;++i){
+        double t = i/(N-1.0);
+        log_nodes[i] = std::exp(-20 + 20*t);
+        cluster_nodes[i] = 0.3 + 0.7*std::pow(2*t-1,7);
+    }
+
+    for(auto const * nodes : {&log_nodes,&cluster_nodes}){
+        std::uniform_real_distribution<double> dist(nodes->front()-0.1,nodes->back()+0.1);
+        std::vector<double> X(1 << 16);
+        for(auto & x : X){
+            x = dist(gen);
+        }
+        X.insert(X.end(),nodes->begin(),nodes->begin()+1000);
+
+        grob::GridVector<double> V(*nodes);
+        grob::GridBucket<double> B(*nodes);
+        size_t check_v = 0,check_b = 0,check_b8 = 0;
+        std::cout << "N = " << N << ": GridVector " << bench_ns(V,X,check_v) <<
+            " ns, GridBucket " << bench_ns(B,X,check_b) << " ns";
+        B.rebuild(8*N);
+        std::cout << ", GridBucket(buckets = " << B.buckets() << ") " << bench_ns(B,X,check_b8) << " ns" << std::endl;
+        TEST(check_b == check_b8,true);
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/conditional_sampler.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(3 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = t*t;
+    }
+    return nodes;
+}
+
+/// @brief sampling of peaked 2-dim density on ragged grid: conditional sampler vs rejection from bounding box
+int main(){
+    std::mt19937_64 gen(42);
+    auto fb = [](auto const & P){auto [x,y] = P;return std::exp(-50*((x-0.3)*(x-0.3) + (y-0.6)*(y-0.6)));};
+    auto FB = grob::make_function_f(grob::make_grid_f(grob::GridUniform<double>(0,1,101),
+        [](size_t i){return grob::GridVector<double>(inner_nodes(30 + i));}),fb);
+    auto SB = grob::make_conditional_sampler(FB);
+    double f_max = *std::max_element(FB.Values.begin(),FB.Values.end());
+    std::uniform_real_distribution<double> dist(0,1);
+    const size_t nb = 1 << 18;
+    double s_0 = 0,s_1 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<nb;){
+        double x = dist(gen),y = dist(gen);
+        if(dist(gen)*f_max < FB(x,y)){
+            s_0 += x;
+            ++k;
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<nb;++k){
+        s_1 += std::get<0>(SB(gen));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double ns = 1e9/nb;
+    std::cout << "peaked 2-dim density: rejection " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        " ns, conditional sampler " << std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    TEST(std::abs(s_0 - s_1) < 1e-2*s_0,true);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+template <typename FuncType>
+double bench(FuncType const & F,std::vector<double> const & xs,double & sum){
+    auto t0 = std::chrono::steady_clock::now();
+    for(double x : xs){
+        sum += F(x);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/xs.size();
+}
+
+/// @brief random evaluation, interpolator_spline1D vs precomputed coefficients
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.2,1.2);
+    std::vector<double> xs(1 << 20);
+    for(auto & x : xs){
+        x = dist(gen);
+    }
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+
+    for(size_t M : {100,10000,1000000}){
+        double s_0 = 0,s_1 = 0;
+        auto FU = grob::make_function_f<grob::spline1D>(grob::GridUniform<double>(0,1,M),f);
+        auto SU = grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),f);
+        double t_0 = bench(FU,xs,s_0),t_1 = bench(SU,xs,s_1);
+        TEST(std::abs(s_0 - s_1) < 1e-9*std::abs(s_0),true);
+        std::cout << "uniform " << M << ": spline1D " << t_0 << " ns, cubic_spline " << t_1 << " ns" << std::endl;
+        auto FV = grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes(M)),f);
+        auto SV = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),f);
+        s_0 = s_1 = 0;
+        t_0 = bench(FV,xs,s_0),t_1 = bench(SV,xs,s_1);
+        TEST(std::abs(s_0 - s_1) < 1e-9*std::abs(s_0),true);
+        std::cout << "vector " << M << ": spline1D " << t_0 << " ns, cubic_spline " << t_1 << " ns" << std::endl;
+    }
+    return 0;
+}
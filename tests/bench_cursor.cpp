@@ -0,0 +1,48 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @brief random walk with small steps: binary search in pos vs cursor, which starts from previous cell
+int main(){
+    const size_t N = 100000;
+    std::vector<double> nodes(N);
+    for(size_t i=0;i<N;++i){
+        double t = i/(N-1.0);
+        nodes[i] = t*t*t;
+    }
+    grob::GridVector<double> V(nodes);
+
+    std::mt19937 gen(42);
+    std::normal_distribution<double> step(0,1e-4);
+    std::vector<double> X(1 << 20);
+    double x = 0.5;
+    for(auto & xi : X){
+        x += step(gen);
+        x = (x < -0.1 ? -0.1 : (x > 1.1 ? 1.1 : x));
+        xi = x;
+    }
+
+    auto C = V.cursor();
+    size_t check_pos = 0,check_cursor = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(double xi : X){
+        check_pos += V.pos(xi);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(double xi : X){
+        check_cursor += C.locate(xi);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(check_pos,check_cursor);
+    double ns = 1e9/X.size();
+    std::cout << "random walk, GridVector(" << N << "): pos " <<
+        std::chrono::duration<double>(t1-t0).count()*ns << " ns, cursor " <<
+        std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    return 0;
+}
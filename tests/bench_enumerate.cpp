@@ -0,0 +1,84 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/csv_io.hpp"
+#include <vector>
+#include <sstream>
+#include <chrono>
+#include <cmath>
+
+/// @brief sum of f(grid point) by loop with MultiIncrement and operator[] (used before enumerate)
+template <typename GridType,typename FuncType>
+double sweep_loop(GridType const & G,std::vector<double> & V,FuncType const & f){
+    size_t i = 0;
+    for(auto MI = G.MultiZero();!G.IsEnd(MI);++i,G.MultiIncrement(MI)){
+        V[i] = f(G[MI]);
+    }
+    return V[i/2];
+}
+
+template <typename GridType,typename FuncType>
+double sweep_enumerate(GridType const & G,std::vector<double> & V,FuncType const & f){
+    for(auto [MI,i,X] : G.enumerate()){
+        V[i] = f(X);
+    }
+    return V[V.size()/2];
+}
+
+template <typename Action>
+double bench_ns(Action && A,size_t n,size_t repeat = 20){
+    A();
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        A();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/(n*repeat);
+}
+
+template <typename GridType,typename FuncType>
+void compare(std::string const & name,GridType const & G,FuncType const & f){
+    std::vector<double> V1(G.size()),V2(G.size());
+    double t_loop = bench_ns([&]{sweep_loop(G,V1,f);},G.size());
+    double t_enum = bench_ns([&]{sweep_enumerate(G,V2,f);},G.size());
+    TEST(V1 == V2,true);
+    std::cout << name << " (" << G.size() << "): MultiIncrement loop " << t_loop <<
+        " ns, enumerate " << t_enum << " ns" << std::endl;
+}
+
+int main(){
+    auto f1 = [](double x){return 2*x;};
+    auto f2 = [](auto const & P){auto [x,y] = P;return x + 2*y;};
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x + 2*y + 3*z;};
+    auto fv = [](auto const & P){return std::get<0>(P).volume()*std::get<1>(P).volume()*std::get<2>(P).volume();};
+
+    compare("1-dim vector",grob::GridVector<double>(std::vector<double>(1 << 20,1.0)),f1);
+    compare("2-dim ragged",grob::make_grid_f(grob::GridUniform<double>(0,1,1001),[](size_t i){
+        return grob::GridUniform<double>(0,1,500 + i % 100);
+    }),f2);
+    compare("2-dim ragged, short rows",grob::make_grid_f(grob::GridUniform<double>(0,1,100001),[](size_t i){
+        return grob::GridUniform<double>(0,1,4 + i % 5);
+    }),f2);
+    compare("3-dim ragged histogram",grob::mesh_grids(grob::GridUniformHisto<double>(-1,1,21),
+        grob::make_grid_f(grob::GridUniformHisto<double>(0,1,41),[](size_t i){
+            return grob::GridUniformHisto<double>(0,1,20 + i);
+        })),fv);
+    compare("3-dim rectilinear",grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,101),
+        grob::GridUniform<double>(0,1,101),grob::GridUniform<double>(0,1,101)),f3);
+
+    // users of enumerate: map, map_pack and csv export
+    auto F = grob::make_function_f(grob::make_grid_f(grob::GridUniform<double>(0,1,1001),[](size_t i){
+        return grob::GridUniform<double>(0,1,500 + i % 100);
+    }),f2);
+    std::cout << "GridObject::map " << bench_ns([&]{F.map(f2);},F.size()) << " ns, map_pack " <<
+        bench_ns([&]{F.map_pack([](double x,double y){return x - y;});},F.size()) << " ns";
+    auto FS = grob::make_function_f(grob::make_grid_f(grob::GridUniform<double>(0,1,101),[](size_t i){
+        return grob::GridUniform<double>(0,1,50 + i);
+    }),f2);
+    std::cout << ", csv save " << bench_ns([&]{
+        std::stringstream S;
+        grob::as_csv(FS).save(S);
+    },FS.size(),3) << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @return time per point of scalar and batch evaluation in ns
+template <typename FuncType>
+std::pair<double,double> bench(FuncType const & F,std::vector<double> const & xs,double & s_scalar,double & s_batch){
+    std::vector<double> out(xs.size());
+    auto t0 = std::chrono::steady_clock::now();
+    for(double x : xs){
+        s_scalar += F(x);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    F.eval_batch(xs.data(),xs.size(),out.data());
+    for(double r : out){
+        s_batch += r;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double ns = 1e9/xs.size();
+    return {std::chrono::duration<double>(t1-t0).count()*ns,std::chrono::duration<double>(t2-t1).count()*ns};
+}
+
+/// @brief random points, uniform table larger than cache, vector grid of moderate size (search bound)
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 22;
+    std::vector<double> xs(N);
+    for(auto & x : xs){
+        x = dist(gen);
+    }
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+
+    const size_t M = 1 << 23,MV = 1 << 16;
+    std::vector<double> nodes(MV);
+    for(size_t i=0;i<MV;++i){
+        nodes[i] = std::pow(i/(MV - 1.0),1.5);
+    }
+    double s_s = 0,s_b = 0;
+    auto FL = grob::make_function_f<grob::linear_interpolator>(grob::GridUniform<double>(0,1,M),f);
+    auto [t_s,t_b] = bench(FL,xs,s_s,s_b);
+    std::cout << "linear, uniform " << M << ": eval " << t_s << " ns, eval_batch " << t_b << " ns" << std::endl;
+    auto FLV = grob::make_function_f<grob::linear_interpolator>(grob::GridVector<double>(nodes),f);
+    std::tie(t_s,t_b) = bench(FLV,xs,s_s,s_b);
+    std::cout << "linear, vector " << MV << ": eval " << t_s << " ns, eval_batch " << t_b << " ns" << std::endl;
+    auto FS = grob::make_function_f<grob::spline1D>(grob::GridUniform<double>(0,1,M),f);
+    std::tie(t_s,t_b) = bench(FS,xs,s_s,s_b);
+    std::cout << "spline, uniform " << M << ": eval " << t_s << " ns, eval_batch " << t_b << " ns" << std::endl;
+    auto FSV = grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes),f);
+    std::tie(t_s,t_b) = bench(FSV,xs,s_s,s_b);
+    std::cout << "spline, vector " << MV << ": eval " << t_s << " ns, eval_batch " << t_b << " ns" << std::endl;
+    TEST(std::abs(s_s - s_b) < 1e-9*std::abs(s_s),true);
+
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    std::vector<double> out_b(N);
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto F3b = grob::make_function_f(grob::mesh_grids(grob::GridUniform<double>(0,1,200),
+        grob::mesh_grids(grob::GridUniform<double>(0,1,200),grob::GridUniform<double>(0,1,200))),f3);
+    s_s = s_b = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(auto const & P : X3){
+        s_s += F3b.eval(P);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    F3b.eval_batch(X3.data(),N,out_b.data());
+    for(double r : out_b){
+        s_b += r;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(std::abs(s_s - s_b) < 1e-9*std::abs(s_s),true);
+    std::cout << "multilinear 200^3: eval " << std::chrono::duration<double>(t1-t0).count()*1e9/N <<
+        " ns, eval_batch " << std::chrono::duration<double>(t2-t1).count()*1e9/N << " ns" << std::endl;
+    return 0;
+}
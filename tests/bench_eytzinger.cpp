@@ -0,0 +1,45 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+template <typename GridType,typename T>
+double bench_ns(GridType const & G,std::vector<T> const & X,size_t & check){
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t i=0;i<X.size();++i){
+        check += G.pos(X[i]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/X.size();
+}
+
+/// @brief latency of pos on random points: binary search in sorted nodes vs Eytzinger layout
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    std::vector<double> X(1 << 16);
+    for(auto & x : X){
+        x = dist(gen);
+    }
+
+    std::cout << "latency of pos, ns:" << std::endl;
+    for(size_t N : {1000,10000,100000,1000000,10000000}){
+        std::vector<double> nodes(N);
+        for(size_t i=0;i<N;++i){
+            double t = i/(N-1.0);
+            nodes[i] = t*t*t;
+        }
+        grob::GridVector<double> V(nodes);
+        grob::GridEytzinger<double> E(nodes);
+        size_t check_v = 0,check_e = 0;
+        std::cout << "N = " << N << ": GridVector " << bench_ns(V,X,check_v) <<
+            ", GridEytzinger " << bench_ns(E,X,check_e) << std::endl;
+        TEST(check_v,check_e);
+    }
+    return 0;
+}
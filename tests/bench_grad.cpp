@@ -0,0 +1,62 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+/// @brief eval_grad vs 2*Dim+1 calls of eval with central differences
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 18;
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto bench = [&](auto const & F,const char * name){
+        const double dx = 1e-6;
+        double s_0 = 0,s_1 = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for(auto const & P : X3){
+            auto [x,y,z] = P;
+            s_0 += F.eval(P) + (F.eval(x+dx,y,z) - F.eval(x-dx,y,z) +
+                    F.eval(x,y+dx,z) - F.eval(x,y-dx,z) + F.eval(x,y,z+dx) - F.eval(x,y,z-dx))/(2*dx);
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        for(auto const & P : X3){
+            auto [v,g] = F.eval_grad(P);
+            auto [gx,gy,gz] = g;
+            s_1 += v + gx + gy + gz;
+        }
+        auto t2 = std::chrono::steady_clock::now();
+        std::cout << name << ": finite differences " << std::chrono::duration<double>(t1-t0).count()*1e9/N <<
+            " ns, eval_grad " << std::chrono::duration<double>(t2-t1).count()*1e9/N << " ns" << std::endl;
+        TEST(std::abs(s_0 - s_1) < 1e-3*std::abs(s_1),true);
+    };
+    typedef grob::interProd3<grob::spline1D,grob::spline1D,grob::spline1D> S3;
+    auto G3b = grob::mesh_grids(grob::GridUniform<double>(0,1,100),
+        grob::mesh_grids(grob::GridUniform<double>(0,1,100),grob::GridUniform<double>(0,1,100)));
+    auto G3r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        });
+    bench(grob::make_function_f(G3b,f3),"multilinear 100^3");
+    bench(grob::make_function_f<S3>(G3b,f3),"spline 100^3");
+    bench(grob::make_function_f<S3>(G3r,f3),"spline ragged");
+    return 0;
+}
@@ -0,0 +1,57 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/integral.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @brief range integrals by integral_index vs trapezoid loop over nodes
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+    std::vector<double> ab(1 << 18);
+    for(auto & x : ab){
+        x = dist(gen);
+    }
+    auto FB = grob::make_function_f(grob::GridVector<double>(nodes(1000)),f);
+    auto IB = grob::make_integral_index(FB);
+    double s_0 = 0,s_1 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t k=0;k+1<ab.size();k += 2){
+        // trapezoid loop over nodes, the way ranges are integrated without index
+        double a = std::min(ab[k],ab[k+1]),b = std::max(ab[k],ab[k+1]);
+        double sum = 0;
+        size_t i = FB.Grid.pos(a),j = FB.Grid.pos(b);
+        double fa = FB(a);
+        double xl = a;
+        for(size_t m=i+1;m<=j;++m){
+            sum += (FB.Values[m] + fa)*(FB.Grid[m] - xl)/2;
+            fa = FB.Values[m];
+            xl = FB.Grid[m];
+        }
+        sum += (FB(b) + fa)*(b - xl)/2;
+        s_0 += sum;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t k=0;k+1<ab.size();k += 2){
+        s_1 += IB.integral(std::min(ab[k],ab[k+1]),std::max(ab[k],ab[k+1]));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    double ns = 2e9/ab.size();
+    std::cout << "integral 1000 nodes: node loop " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        " ns, integral_index " << std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    TEST(std::abs(s_0 - s_1) < 1e-9*std::abs(s_0),true);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/inverse.hpp"
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @brief lookup of tabulated inverse vs root solve per query
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    auto f = [](double x){return x*x*x + x + 1;};
+    auto FS = grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes(30)),f);
+    auto US = grob::inverse<grob::spline1D>(FS,1000);
+    std::vector<double> ys(1 << 18);
+    for(auto & y : ys){
+        y = f(dist(gen));
+    }
+    double s_0 = 0,s_1 = 0,s_2 = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(double y : ys){
+        size_t i = std::upper_bound(FS.Values.begin(),FS.Values.end(),y) - FS.Values.begin();
+        i = (i < 1 ? 1 : (i > FS.Grid.size() - 1 ? FS.Grid.size() - 1 : i)) - 1;
+        s_0 += grob::_inverse_impl::solve_cell(FS,FS.Grid[i],FS.Grid[i+1],FS.Values[i],FS.Values[i+1],y,1e-10);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(double y : ys){
+        s_1 += US(y);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    auto UL1 = grob::inverse<grob::linear_interpolator>(FS,1 << 14);
+    for(double y : ys){
+        s_2 += UL1(y);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    double ns = 1e9/ys.size();
+    std::cout << "root solve " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        " ns, spline inverse " << std::chrono::duration<double>(t2-t1).count()*ns <<
+        " ns, linear inverse " << std::chrono::duration<double>(t3-t2).count()*ns << " ns" << std::endl;
+    TEST(std::abs(s_0 - s_1) < 1e-5*s_0 && std::abs(s_0 - s_2) < 1e-5*s_0,true);
+    return 0;
+}
@@ -0,0 +1,58 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+template <typename GridType,typename...Args>
+size_t old_linear(GridType const & G,bool & b,Args const&...args){
+    auto bMI = G.spos(args...);
+    b = std::get<0>(bMI);
+    return b ? G.LinearIndex(std::get<1>(bMI)) : 0;
+}
+
+/// @brief fill of 3D ragged histogram: locate_linear vs spos and LinearIndex
+int main(){
+    auto G2 = grob::make_grid_f(grob::GridUniformHisto<double>(0,1,11),[](size_t i){
+        return grob::GridUniformHisto<double>(-0.1*i,1 + 0.1*i,5 + i);
+    });
+    auto G3 = grob::mesh_grids(grob::GridUniformHisto<double>(-1,1,9),G2);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.2,2.2);
+    const size_t N = 1 << 20;
+    std::vector<grob::Point<double,double,double>> X(N);
+    for(auto & P : X){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+
+    auto H = grob::make_histo<double>(G3);
+    auto H_old = grob::make_histo<double>(G3);
+    auto t0 = std::chrono::steady_clock::now();
+    size_t inside_new = 0;
+    for(auto const & P : X){
+        inside_new += H.put_point(1.0,P);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    size_t inside_old = 0;
+    for(auto const & P : X){
+        bool b;
+        size_t li = old_linear(H_old.Grid,b,std::get<0>(P),std::get<1>(P),std::get<2>(P));
+        if(b){
+            H_old.Values[li] += 1.0;
+            ++inside_old;
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(inside_new,inside_old);
+    TEST(H.Values == H_old.Values,true);
+    double ns = 1e9/N;
+    std::cout << "3D ragged histogram fill: locate_linear " <<
+        std::chrono::duration<double>(t1-t0).count()*ns << " ns, spos + LinearIndex " <<
+        std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,45 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @brief histogram fill over 15 decades: functional log grid vs GridLogLinear, scalar and put_batch
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-9,9);
+    const size_t N = 1 << 20;
+    std::vector<double> X(N);
+    for(size_t i=0;i<N;++i){
+        X[i] = std::pow(10.0,dist(gen));
+    }
+    grob::GridLogLinearHisto<double> GH(1e-6,1e6,5);
+    auto H = grob::make_histo<double>(GH);
+    auto H_log = grob::make_histo<double>(grob::make_func_histo_grid(1e-6,1e6,GH.size()+1,
+                    [](double x){return std::log(x);},[](double x){return std::exp(x);}));
+
+    auto t0 = std::chrono::steady_clock::now();
+    size_t inside_log = 0;
+    for(double x : X){
+        inside_log += H_log.put(1.0,x);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    size_t inside_scalar = 0;
+    for(double x : X){
+        inside_scalar += H.put(1.0,x);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    size_t inside_batch = H.put_batch(1.0,X.data(),X.size());
+    auto t3 = std::chrono::steady_clock::now();
+    TEST(inside_scalar,inside_batch);
+
+    double ns = 1e9/N;
+    std::cout << "fill, ns/pt: log grid " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        ", loglinear " << std::chrono::duration<double>(t2-t1).count()*ns <<
+        ", loglinear put_batch " << std::chrono::duration<double>(t3-t2).count()*ns << std::endl;
+    return 0;
+}
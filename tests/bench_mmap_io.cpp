@@ -0,0 +1,42 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/mmap_io.hpp"
+#include <vector>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(5 + i % 17);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = (1 + 0.001*i)*t*t;
+    }
+    return nodes;
+}
+
+/// @brief load of large function over ragged grid: mapping vs reading file into buffer
+int main(){
+    const std::string path = "/tmp/grob_bench_mmap_io";
+    const size_t M = 20000;
+    auto f = [](auto const & P){auto [x,y] = P;return x*x + y;};
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto FB = grob::make_function_f<I2>(
+        grob::make_grid_f(grob::GridUniform<double>(0,1,4*M),
+            [](size_t i){return grob::GridVector<double>(inner_nodes(i + 200));}),f);
+    grob::mmap_io::save(path,FB);
+    auto t0 = std::chrono::steady_clock::now();
+    auto MB = grob::mmap_io::load<decltype(FB)>(path);
+    auto t1 = std::chrono::steady_clock::now();
+    std::ifstream in(path,std::ios::binary);
+    std::vector<char> buffer((std::istreambuf_iterator<char>(in)),std::istreambuf_iterator<char>());
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(MB->size(),FB.size());
+    std::cout << "load of " << MB.File->size()/1024 << " KiB: mmap_io " <<
+        std::chrono::duration<double>(t1-t0).count()*1e6 << " us, reading file " <<
+        std::chrono::duration<double>(t2-t1).count()*1e6 << " us" << std::endl;
+    std::remove(path.c_str());
+    return 0;
+}
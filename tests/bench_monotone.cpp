@@ -0,0 +1,54 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+template <typename FuncType>
+double bench(FuncType const & F,std::vector<double> const & xs,double & sum){
+    auto t0 = std::chrono::steady_clock::now();
+    for(double x : xs){
+        sum += F(x);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/xs.size();
+}
+
+/// @brief evaluation cost of monotone splines with cached slopes vs linear interpolation
+int main(){
+    using grob::spline_kind;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    std::vector<double> xs(1 << 20);
+    for(auto & x : xs){
+        x = dist(gen);
+    }
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+    for(size_t M : {100,10000}){
+        double s_0 = 0,s_1 = 0,s_2 = 0;
+        auto LU = grob::make_function_f<grob::linear_interpolator>(grob::GridUniform<double>(0,1,M),f);
+        auto PU = grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),f,spline_kind::pchip);
+        auto AU = grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),f,spline_kind::akima);
+        double t_0 = bench(LU,xs,s_0),t_1 = bench(PU,xs,s_1),t_2 = bench(AU,xs,s_2);
+        std::cout << "uniform " << M << ": linear " << t_0 << " ns, pchip " << t_1 << " ns, akima " << t_2 << " ns" << std::endl;
+        auto LV = grob::make_function_f<grob::linear_interpolator>(grob::GridVector<double>(nodes(M)),f);
+        auto PV = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),f,spline_kind::pchip);
+        auto AV = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),f,spline_kind::akima);
+        t_0 = bench(LV,xs,s_0),t_1 = bench(PV,xs,s_1),t_2 = bench(AV,xs,s_2);
+        std::cout << "vector " << M << ": linear " << t_0 << " ns, pchip " << t_1 << " ns, akima " << t_2 << " ns" << std::endl;
+        TEST(std::abs(s_0 - s_1) < 1e-3*std::abs(s_0) && std::abs(s_0 - s_2) < 1e-3*std::abs(s_0),true);
+    }
+    return 0;
+}
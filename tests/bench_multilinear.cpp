@@ -0,0 +1,63 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+typedef grob::interProd<grob::linear_interpolator,I2> I3;
+
+template <typename Interpolator,typename FuncType,typename PointsType>
+double bench(FuncType const & F,PointsType const & X,double & sum){
+    auto t0 = std::chrono::steady_clock::now();
+    for(auto const & P : X){
+        sum += Interpolator::interpolate(F.Grid,F.Values,P);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/X.size();
+}
+
+/// @brief random point evaluation, multilinear_interpolator vs nested interProd
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 18;
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    auto F3m = grob::make_function_f<I3>(grob::mesh_grids(grob::GridUniform<double>(0,1,41),
+        grob::mesh_grids(grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,31))),f3);
+    auto F3r = grob::make_function_f<I3>(grob::make_grid_f(grob::GridUniform<double>(0,1,41),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        }),f3);
+    auto F3R = grob::make_function_f<I3>(grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,41),
+        grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,31)),f3);
+    double s_m = 0,s_p = 0;
+    double t_p = bench<I3>(F3m,X3,s_p),t_m = bench<grob::multilinear_interpolator>(F3m,X3,s_m);
+    std::cout << "3D mesh: interProd " << t_p << " ns, multilinear " << t_m << " ns" << std::endl;
+    t_p = bench<I3>(F3r,X3,s_p);
+    t_m = bench<grob::multilinear_interpolator>(F3r,X3,s_m);
+    std::cout << "3D ragged: interProd " << t_p << " ns, multilinear " << t_m << " ns" << std::endl;
+    t_p = bench<I3>(F3R,X3,s_p);
+    t_m = bench<grob::multilinear_interpolator>(F3R,X3,s_m);
+    std::cout << "3D rectilinear: interProd " << t_p << " ns, multilinear " << t_m << " ns" << std::endl;
+    TEST(std::abs(s_m - s_p) < 1e-6*std::abs(s_p),true);
+    return 0;
+}
@@ -0,0 +1,55 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(5 + i % 17);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = (1 + 0.001*i)*t*t;
+    }
+    return nodes;
+}
+
+/// @brief copy and sweep of ragged grid: packed inner grids vs vector of GridVector
+int main(){
+    const size_t M = 20000;
+    grob::GridUniform<double> G0(0,1,M);
+    auto GV = grob::make_grid_f(G0,[](size_t i){return grob::GridVector<double>(inner_nodes(i));});
+    auto GP = grob::make_grid_packed(G0,inner_nodes);
+
+    for(size_t r=0;r<3;++r){
+        auto GP_warm = GP;
+        auto GV_warm = GV;
+    }
+    auto t0 = std::chrono::steady_clock::now();
+    auto GP_copy = GP;
+    auto t1 = std::chrono::steady_clock::now();
+    auto GV_copy = GV;
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(GP_copy.size(),GV_copy.size());
+    std::cout << "copy of " << M << " inner grids: packed " <<
+        std::chrono::duration<double>(t1-t0).count()*1e6 << " us, vector of GridVector " <<
+        std::chrono::duration<double>(t2-t1).count()*1e6 << " us" << std::endl;
+
+    double sum_p = 0,sum_v = 0;
+    t0 = std::chrono::steady_clock::now();
+    for(auto [MI,i,P] : GP.enumerate()){
+        sum_p += std::get<1>(P);
+    }
+    t1 = std::chrono::steady_clock::now();
+    for(auto [MI,i,P] : GV.enumerate()){
+        sum_v += std::get<1>(P);
+    }
+    t2 = std::chrono::steady_clock::now();
+    TEST(sum_p,sum_v);
+    double ns = 1e9/GP.size();
+    std::cout << "sweep: packed " << std::chrono::duration<double>(t1-t0).count()*ns <<
+        " ns, vector of GridVector " << std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    return 0;
+}
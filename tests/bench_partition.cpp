@@ -0,0 +1,36 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <chrono>
+#include <cmath>
+
+/// @brief make_function_f over a ragged 3-dim grid with an expensive function, 1 thread vs 4 threads
+int main(){
+    auto G2 = grob::make_grid_f(grob::GridUniform<double>(0,1,11),[](size_t i){
+        return grob::GridUniform<double>(-0.1*i,1 + 0.1*i,5 + 3*i);
+    });
+    auto G3 = grob::mesh_grids(grob::GridUniform<double>(-1,1,9),G2);
+    auto f = [](auto const & P){
+        auto [x,y,z] = P;
+        double s = 0;
+        for(size_t k=1;k<200;++k){
+            s += std::sin(k*x)*std::cos(k*y)/k + z/(k*k);
+        }
+        return s;
+    };
+    typedef grob::interProd<grob::linear_interpolator,
+                grob::interProd<grob::linear_interpolator,grob::linear_interpolator>> I3;
+    auto t0 = std::chrono::steady_clock::now();
+    auto F1 = grob::make_function_f<I3>(G3,f);
+    auto t1 = std::chrono::steady_clock::now();
+    auto F4 = grob::make_function_f<I3>(G3,f,4);
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(F1.Values == F4.Values,true);
+    std::cout << "make_function_f (" << G3.size() << " points): 1 thread " <<
+        std::chrono::duration<double>(t1-t0).count()*1e3 << " ms, 4 threads " <<
+        std::chrono::duration<double>(t2-t1).count()*1e3 << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+template <typename GridType,typename T>
+void bench(std::string const & name,GridType const & G,std::vector<T> const & X,size_t repeat = 20){
+    std::vector<size_t> out(X.size());
+    size_t check_scalar = 0,check_batch = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        for(size_t i=0;i<X.size();++i){
+            out[i] = G.pos(X[i]);
+        }
+        check_scalar += out[r % out.size()];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        G.pos_batch(X.data(),X.size(),out.data());
+        check_batch += out[r % out.size()];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double ns = 1e9/double(X.size()*repeat);
+    double t_scalar = std::chrono::duration<double>(t1-t0).count()*ns;
+    double t_batch = std::chrono::duration<double>(t2-t1).count()*ns;
+    std::cout << name << ": scalar " << t_scalar << " ns/pt, batch " << t_batch <<
+        " ns/pt, speedup " << t_scalar/t_batch << std::endl;
+    TEST(check_scalar,check_batch);
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+
+    const size_t N = 1 << 20;
+    std::vector<double> Xd(N);
+    std::vector<float> Xf(N);
+    for(size_t i=0;i<N;++i){
+        Xf[i] = Xd[i] = dist(gen);
+    }
+    Xd[3] = Xd[17] = NAN;
+    Xf[3] = Xf[17] = NAN;
+
+    grob::GridUniform<double> Ud(0,1,1001);
+    grob::GridUniform<float> Uf(0,1,1001);
+
+    std::vector<double> nodes(100001);
+    for(size_t i=0;i<nodes.size();++i){
+        double t = i/(nodes.size()-1.0);
+        nodes[i] = t*t*t;
+    }
+    grob::GridVector<double> Vd(nodes);
+    grob::GridVector<float> Vf(std::vector<float>(nodes.begin(),nodes.end()));
+
+    bench("GridUniform<double>",Ud,Xd);
+    bench("GridUniform<float>",Uf,Xf);
+    bench("GridVector<double>",Vd,Xd,5);
+    bench("GridVector<float>",Vf,Xf,5);
+    return 0;
+}
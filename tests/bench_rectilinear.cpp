@@ -0,0 +1,68 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @brief RectilinearGrid vs nested mesh_grids of the same 5 axes:
+/// full traversal with LinearIndex and pos + LinearIndex of random points
+int main(){
+    grob::GridUniform<double> GX(0,1,11);
+    grob::GridVector<double> GY(std::vector<double>{-1,-0.5,0,0.1,0.7,1});
+    grob::GridUniform<double> GZ(0,2,7);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.2,2.2);
+    const size_t N = 1 << 20;
+
+    // full traversal with LinearIndex
+    auto R5 = grob::make_rectilinear_grid(GX,GY,GZ,GX,GY);
+    auto M5 = grob::mesh_grids(GX,grob::mesh_grids(GY,grob::mesh_grids(GZ,grob::mesh_grids(GX,GY))));
+    const size_t repeat = 20;
+    size_t sum_r = 0,sum_m = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        for(auto RI = R5.MultiZero();!R5.IsEnd(RI);R5.MultiIncrement(RI)){
+            sum_r += R5.LinearIndex(RI);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        for(auto MI = M5.MultiZero();!M5.IsEnd(MI);M5.MultiIncrement(MI)){
+            sum_m += M5.LinearIndex(MI);
+        }
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    TEST(sum_r,sum_m);
+    double ns = 1e9/(repeat*R5.size());
+    std::cout << "5D traversal (" << R5.size() << "): RectilinearGrid " <<
+        std::chrono::duration<double>(t1-t0).count()*ns << " ns, mesh_grids " <<
+        std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+
+    // 5D pos + LinearIndex of random points
+    std::vector<grob::Point<double,double,double,double,double>> X5(N);
+    for(auto & P : X5){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen),dist(gen),dist(gen));
+    }
+    sum_r = sum_m = 0;
+    t0 = std::chrono::steady_clock::now();
+    for(auto const & P : X5){
+        auto [x1,x2,x3,x4,x5] = P;
+        sum_r += R5.LinearIndex(R5.pos(x1,x2,x3,x4,x5));
+    }
+    t1 = std::chrono::steady_clock::now();
+    for(auto const & P : X5){
+        auto [x1,x2,x3,x4,x5] = P;
+        sum_m += M5.LinearIndex(M5.pos(x1,x2,x3,x4,x5));
+    }
+    t2 = std::chrono::steady_clock::now();
+    TEST(sum_r,sum_m);
+    ns = 1e9/N;
+    std::cout << "5D pos + LinearIndex: RectilinearGrid " <<
+        std::chrono::duration<double>(t1-t0).count()*ns << " ns, mesh_grids " <<
+        std::chrono::duration<double>(t2-t1).count()*ns << " ns" << std::endl;
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @brief the same interpolation without stencil, interpolator_product falls back to full inner interpolation
+template <typename Interpolator>
+struct no_stencil{
+    template <typename GridType,typename ContainerType,typename Point_t>
+    inline static auto interpolate(GridType const & grid,ContainerType const & values,Point_t const & point){
+        return Interpolator::interpolate(grid,values,point);
+    }
+};
+typedef no_stencil<grob::linear_interpolator> L0;
+typedef no_stencil<grob::spline1D> S0;
+using grob::linear_interpolator;
+using grob::spline1D;
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+template <typename Interpolator,typename FuncType,typename PointsType>
+double bench(FuncType const & F,PointsType const & X,double & sum){
+    auto t0 = std::chrono::steady_clock::now();
+    for(auto const & P : X){
+        sum += Interpolator::interpolate(F.Grid,F.Values,P);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/X.size();
+}
+
+/// @brief random point evaluation of interpolator products through stencils vs full inner interpolation
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 18;
+    std::vector<grob::Point<double,double>> X2(N);
+    for(auto & P : X2){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(3*y);};
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    typedef grob::interProd3<spline1D,spline1D,spline1D> S3;
+    typedef grob::interProd3<S0,S0,S0> S3_0;
+    auto G3r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        });
+
+    // random points, stencil vs full inner interpolation
+    double s_0 = 0,s_1 = 0;
+    auto F2 = grob::make_function_f<grob::interProd<spline1D,spline1D>>(grob::mesh_grids(
+        grob::GridUniform<double>(0,1,1000),grob::GridUniform<double>(0,1,1000)),f2);
+    double t_0 = bench<grob::interProd<S0,S0>>(F2,X2,s_0),t_1 = bench<grob::interProd<spline1D,spline1D>>(F2,X2,s_1);
+    std::cout << "2D spline 1000^2: full inner " << t_0 << " ns, stencil " << t_1 << " ns" << std::endl;
+    auto F3m = grob::make_function_f<S3>(grob::mesh_grids(grob::GridUniform<double>(0,1,100),
+        grob::mesh_grids(grob::GridUniform<double>(0,1,100),grob::GridUniform<double>(0,1,100))),f3);
+    t_0 = bench<S3_0>(F3m,X3,s_0),t_1 = bench<S3>(F3m,X3,s_1);
+    std::cout << "3D spline 100^3: full inner " << t_0 << " ns, stencil " << t_1 << " ns" << std::endl;
+    auto F3r = grob::make_function_f<S3>(G3r,f3);
+    t_0 = bench<S3_0>(F3r,X3,s_0),t_1 = bench<S3>(F3r,X3,s_1);
+    std::cout << "3D spline ragged: full inner " << t_0 << " ns, stencil " << t_1 << " ns" << std::endl;
+    typedef grob::interProd3<linear_interpolator,linear_interpolator,linear_interpolator> L3;
+    t_0 = bench<grob::interProd3<L0,L0,L0>>(F3m,X3,s_0),t_1 = bench<L3>(F3m,X3,s_1);
+    std::cout << "3D linear 100^3: full inner " << t_0 << " ns, stencil " << t_1 << " ns" << std::endl;
+    TEST(std::abs(s_0 - s_1) < 1e-9*std::abs(s_0),true);
+    return 0;
+}
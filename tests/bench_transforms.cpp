@@ -0,0 +1,96 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// number of x, that are not in [G[pos(x)],G[pos(x)+1]]
+template <typename GridType,typename T>
+size_t count_outside(GridType const & G,std::vector<T> const & X){
+    size_t errors = 0;
+    for(T x : X){
+        size_t i = G.pos(x);
+        errors += !(G[i] <= x && x <= G[i+1]);
+    }
+    return errors;
+}
+
+template <typename GridType,typename T>
+double bench_ns(GridType const & G,std::vector<T> const & X,size_t repeat = 10){
+    size_t check = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        for(size_t i=0;i<X.size();++i){
+            check += G.pos(X[i]);
+        }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    if(check == size_t(-1))
+        std::cout << check << std::endl;
+    return std::chrono::duration<double>(t1-t0).count()*1e9/(X.size()*repeat);
+}
+
+template <typename GridType,typename LambdaGridType,typename T>
+void compare(std::string const & name,GridType const & G,LambdaGridType const & GL,std::vector<T> const & X){
+    TEST(count_outside(G,X),0);
+    std::cout << name << ": transform " << bench_ns(G,X) << " ns, lambda " <<
+        bench_ns(GL,X) << " ns" << std::endl;
+}
+
+int main(){
+    double max_err = 0,max_inv_err = 0;
+    for(double x = 1e-10;x < 1e10;x *= 1.0001){
+        max_err = std::max(max_err,std::abs(grob::LogTransform{}(x) - std::log2(x)));
+        double y = grob::LogTransform::inverse{}(grob::LogTransform{}(x));
+        max_inv_err = std::max(max_inv_err,std::abs(y-x)/x);
+    }
+    PVAR(max_err);
+    PVAR(max_inv_err);
+    TEST(max_err < 0.0077,true);
+    TEST(max_inv_err < 1e-13,true);
+    TEST(grob::PowTransform<3>{}(2.0),8.0);
+    TEST(grob::PowTransform<3>::inverse{}(-8.0),-2.0);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    const size_t N = 1 << 16;
+
+    std::vector<double> Xlog(N),Xpos(N);
+    std::vector<float> Xlogf(N);
+    for(size_t i=0;i<N;++i){
+        Xlogf[i] = Xlog[i] = std::exp(std::log(1e-3) + dist(gen)*std::log(1e6));
+        Xpos[i] = 1e-3 + dist(gen)*(1e3-1e-3);
+    }
+
+    grob::GridLog<double> GL(1e-3,1e3,1001);
+    PVAR(GL.size());
+    compare("GridLog<double>",GL,
+        grob::make_func_grid(1e-3,1e3,1001,[](double x){return std::log(x);},[](double x){return std::exp(x);}),
+        Xlog);
+
+    grob::GridLog<float> GLf(1e-3f,1e3f,1001);
+    compare("GridLog<float>",GLf,
+        grob::make_func_grid(1e-3f,1e3f,1001,[](float x){return std::log(x);},[](float x){return std::exp(x);}),
+        Xlogf);
+
+    grob::GridPow<double,3> GP3(1e-3,1e3,1001);
+    compare("GridPow<double,3>",GP3,
+        grob::make_func_grid(1e-3,1e3,1001,[](double x){return std::pow(x,3.0);},[](double x){return std::cbrt(x);}),
+        Xpos);
+
+    grob::GridPow<double,3,2> GP32(1e-3,1e3,1001);
+    compare("GridPow<double,3,2>",GP32,
+        grob::make_func_grid(1e-3,1e3,1001,[](double x){return std::pow(x,1.5);},[](double x){return std::pow(x,2.0/3);}),
+        Xpos);
+
+    grob::GridSqrt<double> GS(1e-3,1e3,1001);
+    compare("GridSqrt<double>",GS,
+        grob::make_func_grid(1e-3,1e3,1001,[](double x){return std::pow(x,0.5);},[](double x){return x*x;}),
+        Xpos);
+
+    return 0;
+}
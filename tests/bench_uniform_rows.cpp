@@ -0,0 +1,58 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+grob::GridUniform<double> equal_row(size_t i){
+    return grob::GridUniform<double>(-0.001*i,1 + 0.002*i,33);
+}
+
+/// @brief pos + LinearIndex of random points in 2-dim grid with uniform rows of equal size:
+/// vector of GridUniform vs GridUniformRows, scalar and batch
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 20;
+    std::vector<std::pair<double,double>> X(N);
+    for(auto & xy : X){
+        xy = {dist(gen),dist(gen)};
+    }
+    grob::GridUniform<double> G0(0,1,2000);
+    auto GU = grob::make_grid_uniform_rows(G0,equal_row);
+
+    // pos + LinearIndex, scalar vs batch
+    auto GV = grob::make_grid_f(G0,equal_row);
+    std::vector<double> xs(N),ys(N);
+    for(size_t k=0;k<N;++k){
+        std::tie(xs[k],ys[k]) = X[k];
+    }
+    std::vector<size_t> oi(N),oj(N);
+    size_t sum_v = 0,sum_u = 0,sum_b = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<N;++k){
+        sum_v += GV.LinearIndex(GV.pos(xs[k],ys[k]));
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for(size_t k=0;k<N;++k){
+        sum_u += GU.LinearIndex(GU.pos(xs[k],ys[k]));
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    GU.pos_batch(xs.data(),ys.data(),N,oi.data(),oj.data());
+    for(size_t k=0;k<N;++k){
+        sum_b += oi[k]*33 + oj[k];
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    TEST(sum_u,sum_v);
+    TEST(sum_b,sum_v);
+    double ns = 1e9/N;
+    std::cout << "2D pos + LinearIndex: vector of GridUniform " <<
+        std::chrono::duration<double>(t1-t0).count()*ns << " ns, UniformRows " <<
+        std::chrono::duration<double>(t2-t1).count()*ns << " ns, UniformRows batch " <<
+        std::chrono::duration<double>(t3-t2).count()*ns << " ns" << std::endl;
+    return 0;
+}
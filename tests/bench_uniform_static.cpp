@@ -0,0 +1,75 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+
+/// @brief lookup behind function boundary: runtime grid parameters are loaded from memory on every call,
+/// static grid parameters are immediate constants
+template <typename GridType>
+__attribute__((noinline)) size_t locate(GridType const & G,double x){
+    return G.pos(x);
+}
+
+template <typename Action>
+double bench_ns(Action && A,size_t n,size_t repeat = 5){
+    auto t0 = std::chrono::steady_clock::now();
+    for(size_t r=0;r<repeat;++r){
+        A();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/(n*repeat);
+}
+
+int main(){
+    typedef grob::GridUniformStatic<double,101,std::ratio<-1>,std::ratio<3,2>> GS_t;
+    constexpr GS_t GS{};
+    grob::GridUniform<double> GR(-1.0,1.5,101);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.5,2.0);
+    std::vector<double> X(1 << 20),Y(X.size()),Z(X.size());
+    for(size_t k=0;k<X.size();++k){
+        X[k] = dist(gen);
+        Y[k] = dist(gen);
+        Z[k] = dist(gen);
+    }
+    const size_t n = X.size();
+
+    // 1. interpolation in loop: parameters of runtime grid are hoisted into registers
+    auto f = [](double x){return std::sin(x);};
+    auto FS = grob::make_function_f(GS,f);
+    auto FR = grob::make_function_f(GR,f);
+    double sum_s = 0,sum_r = 0;
+    double ts = bench_ns([&]{for(double x : X) sum_s += FS(x);},n);
+    double tr = bench_ns([&]{for(double x : X) sum_r += FR(x);},n);
+    TEST(std::abs(sum_s - sum_r) < 1e-9*n,true);
+    std::cout << "linear interpolation in loop: static " << ts << " ns, runtime " << tr << " ns" << std::endl;
+
+    // 2. lookup behind function boundary
+    size_t idx_s = 0,idx_r = 0;
+    ts = bench_ns([&]{for(double x : X) idx_s += locate(GS,x);},n);
+    tr = bench_ns([&]{for(double x : X) idx_r += locate(GR,x);},n);
+    TEST(idx_s,idx_r);
+    std::cout << "pos behind call: static " << ts << " ns, runtime " << tr << " ns" << std::endl;
+
+    // 3. 3-dim histogram fill: linear index of mesh needs sizes of inner grids
+    typedef grob::GridUniformStaticHisto<double,65,std::ratio<-1>,std::ratio<3,2>> HS_t;
+    auto HS = grob::make_histo<double>(grob::mesh_grids(HS_t{},grob::mesh_grids(HS_t{},HS_t{})));
+    grob::GridUniformHisto<double> HR_1(-1.0,1.5,65);
+    auto HR = grob::make_histo<double>(grob::mesh_grids(HR_1,grob::mesh_grids(HR_1,HR_1)));
+    ts = bench_ns([&]{for(size_t k=0;k<n;++k) HS.put(1.0,X[k],Y[k],Z[k]);},n);
+    tr = bench_ns([&]{for(size_t k=0;k<n;++k) HR.put(1.0,X[k],Y[k],Z[k]);},n);
+    double diff = 0;
+    for(size_t i=0;i<HS.Values.size();++i){
+        diff += std::abs(HS.Values[i] - HR.Values[i]);
+    }
+    TEST(diff,0);
+    std::cout << "3-dim histogram fill: static " << ts << " ns, runtime " << tr << " ns" << std::endl;
+    std::cout << "sizeof: static grid " << sizeof(GS) << ", runtime grid " << sizeof(GR) <<
+        ", static 3-dim histogram grid " << sizeof(HS.Grid) << ", runtime " << sizeof(HR.Grid) << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/value_layout.hpp"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <tuple>
+#include <string>
+
+/// @brief random point evaluation of row-major, Morton and tiled layouts of the same function
+/// for tables which fit in last level cache (32 MiB) and well above it (about 1 GiB, 300 MiB L3 on test machine).
+/// Laid out copies are made one at a time, so peak memory is about three tables
+
+/// @param chained if true, each point waits for previous result, so time is latency rather than throughput
+template <typename FuncType,typename PointsType>
+double bench(FuncType const & F,PointsType const & X,double & sum,bool chained){
+    auto t0 = std::chrono::steady_clock::now();
+    double dep = 0;
+    for(auto const & P : X){
+        double r = std::apply([&](auto x,auto...y){return F(x + dep,y...);},P.as_tuple());
+        if(chained)
+            dep = 0*r;
+        sum += r;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(t1-t0).count()*1e9/X.size();
+}
+
+template <typename Layout,typename FuncType,typename PointsType>
+void compare(std::string const & name,FuncType const & F,PointsType const & X,double t_r[2],double s_r[2]){
+    auto FL = grob::with_layout<Layout>(F);
+    for(bool chained : {false,true}){
+        double s = 0;
+        double t = bench(FL,X,s,chained);
+        TEST(s,s_r[chained]);
+        std::cout << "    " << name << (chained ? " chained " : " independent ") << t <<
+            " ns (row-major " << t_r[chained] << " ns)" << std::endl;
+    }
+}
+
+template <typename FuncType,typename PointsType>
+void row_major(FuncType const & F,PointsType const & X,double t_r[2],double s_r[2]){
+    for(bool chained : {false,true}){
+        s_r[chained] = 0;
+        t_r[chained] = bench(F,X,s_r[chained],chained);
+    }
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    const size_t N = 1 << 22;
+    double t_r[2],s_r[2];
+
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(y);};
+    std::vector<grob::Point<double,double>> X2(N);
+    for(auto & P : X2){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    for(size_t n2 : {64,2048,11584}){
+        auto F2 = grob::make_function_f<I2>(grob::mesh_grids(grob::GridUniform<double>(0,1,n2),
+            grob::GridUniform<double>(0,1,n2)),f2);
+        std::cout << "2D " << n2 << "x" << n2 << " (" << (n2*n2*sizeof(double) >> 20) << " MiB):" << std::endl;
+        row_major(F2,X2,t_r,s_r);
+        compare<grob::morton_layout<2>>("morton",F2,X2,t_r,s_r);
+        compare<grob::tiled_layout<2,8>>("tiled 8x8",F2,X2,t_r,s_r);
+    }
+
+    typedef grob::interProd<grob::linear_interpolator,I2> I3;
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y + z;};
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    for(size_t n3 : {16,160,512}){
+        auto F3 = grob::make_function_f<I3>(grob::mesh_grids(grob::GridUniform<double>(0,1,n3),
+            grob::mesh_grids(grob::GridUniform<double>(0,1,n3),grob::GridUniform<double>(0,1,n3))),f3);
+        std::cout << "3D " << n3 << "^3 (" << (n3*n3*n3*sizeof(double) >> 20) << " MiB):" << std::endl;
+        row_major(F3,X3,t_r,s_r);
+        compare<grob::morton_layout<3>>("morton",F3,X3,t_r,s_r);
+        compare<grob::tiled_layout<3,4>>("tiled 4x4x4",F3,X3,t_r,s_r);
+    }
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/alias_sampler.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+
+/// @return max over bins of |count - expected|/sqrt(expected)
+template <typename HistoType>
+double max_deviation(HistoType const & H,std::vector<size_t> const & counts,size_t n){
+    double total = 0;
+    for(size_t i=0;i<H.Values.size();++i){
+        total += H.Values[i];
+    }
+    double dev = 0;
+    for(size_t i=0;i<counts.size();++i){
+        double expected = n*H.Values[i]/total;
+        if(expected == 0){
+            dev = std::max(dev,double(counts[i]));
+        } else {
+            dev = std::max(dev,std::abs(counts[i] - expected)/std::sqrt(expected));
+        }
+    }
+    return dev;
+}
+
+/// @brief engine which always returns its maximum, generate_canonical of it rounds to 1
+struct max_engine{
+    typedef uint32_t result_type;
+    static constexpr result_type min(){return 0;}
+    static constexpr result_type max(){return 1000;}
+    result_type operator()(){return max();}
+};
+
+int main(){
+    std::mt19937_64 gen(42);
+    const size_t n = 1 << 20;
+
+    // 1-dim: frequencies follow values, points are inside their bins, empty bins are never drawn
+    auto H = grob::make_histo<double>(grob::GridVectorHisto<double>(std::vector<double>{0,0.1,0.5,0.6,1,3}));
+    H.Values = {1,0,5,2.5,0.5};
+    auto S = grob::make_alias_sampler(H);
+    std::vector<size_t> counts(H.Values.size(),0);
+    size_t outside = 0;
+    for(size_t k=0;k<n;++k){
+        auto [i,x] = S(gen);
+        ++counts[i];
+        outside += !(H.Grid[i].left <= x && x < H.Grid[i].right);
+    }
+    TEST(outside,0);
+    TEST(counts[1],0);
+    TEST(max_deviation(H,counts,n) < 5,true);
+
+    // 32-bit engine and the same result of sample_n
+    std::mt19937 gen32(7);
+    std::vector<decltype(S)::sample_type> out(n);
+    S.sample_n(gen32,out);
+    std::fill(counts.begin(),counts.end(),0);
+    outside = 0;
+    for(auto [i,x] : out){
+        ++counts[i];
+        outside += !(H.Grid[i].left <= x && x < H.Grid[i].right);
+    }
+    TEST(outside,0);
+    TEST(max_deviation(H,counts,n) < 5,true);
+
+    // N-dim ragged histogram: bins in linear order of values
+    auto G2 = grob::make_grid_f(grob::GridUniformHisto<double>(0,1,6),[](size_t i){
+        return grob::GridUniformHisto<double>(-0.1*i,1 + 0.1*i,3 + i);
+    });
+    auto H2 = grob::make_histo<double>(G2);
+    for(size_t i=0;i<H2.Values.size();++i){
+        H2.Values[i] = 1 + (i*7) % 5;
+    }
+    auto S2 = grob::make_alias_sampler(H2);
+    std::vector<decltype(S2)::sample_type> out2(n);
+    S2.sample_n(gen,out2);
+    counts.assign(H2.Values.size(),0);
+    outside = 0;
+    for(auto const & [i,P] : out2){
+        ++counts[i];
+        auto [x,y] = P;
+        auto li = H2.Grid.locate_linear(x,y);
+        outside += !(li && *li == i);
+    }
+    TEST(outside,0);
+    TEST(max_deviation(H2,counts,n) < 5,true);
+
+    // 3-dim rectilinear
+    auto H3 = grob::make_histo<double>(grob::make_rectilinear_grid(grob::GridUniformHisto<double>(0,1,5),
+        grob::GridVectorHisto<double>(std::vector<double>{0,0.1,0.5,1}),grob::GridUniformHisto<double>(-1,1,3)));
+    for(size_t i=0;i<H3.Values.size();++i){
+        H3.Values[i] = i % 3;
+    }
+    auto S3 = grob::make_alias_sampler(H3);
+    counts.assign(H3.Values.size(),0);
+    outside = 0;
+    for(size_t k=0;k<n;++k){
+        auto [i,P] = S3(gen);
+        ++counts[i];
+        auto [x,y,z] = P;
+        auto li = H3.Grid.locate_linear(x,y,z);
+        outside += !(li && *li == i);
+    }
+    TEST(outside,0);
+    TEST(max_deviation(H3,counts,n) < 5,true);
+
+    // upper end of engine range gives valid bin
+    max_engine gen_max;
+    TEST(grob::_sampler_impl::uniform01(gen_max) < 1,true);
+    auto [i_max,x_max] = S(gen_max);
+    TEST(i_max < H.Values.size() && H.Values[i_max] > 0,true);
+    TEST(H.Grid[i_max].left <= x_max && x_max <= H.Grid[i_max].right,true);
+    S.sample_n(gen_max,out.data(),16);
+    outside = 0;
+    for(size_t k=0;k<16;++k){
+        outside += !(out[k].first == i_max);
+    }
+    TEST(outside,0);
+
+    // wrong weights
+    bool thrown = false;
+    try{
+        H.Values[2] = -1;
+        grob::make_alias_sampler(H);
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    return 0;
+}
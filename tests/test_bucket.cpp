@@ -0,0 +1,58 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+int main(){
+    std::mt19937 gen(42);
+
+    const size_t N = 100000;
+    // log spaced nodes and nodes clustered near 0.3
+    std::vector<double> log_nodes(N),cluster_nodes(N);
+    for(size_t i=0;i<N;++i){
+        double t = i/(N-1.0);
+        log_nodes[i] = std::exp(-20 + 20*t);
+        cluster_nodes[i] = 0.3 + 0.7*std::pow(2*t-1,7);
+    }
+
+    for(auto const * nodes : {&log_nodes,&cluster_nodes}){
+        std::uniform_real_distribution<double> dist(nodes->front()-0.1,nodes->back()+0.1);
+        std::vector<double> X(1 << 16);
+        for(auto & x : X){
+            x = dist(gen);
+        }
+        X[5] = NAN;
+
+        grob::GridVector<double> V(*nodes);
+        for(size_t buckets : {size_t(0),size_t(1),size_t(7),N/10,4*N}){
+            grob::GridBucket<double> B(*nodes,buckets);
+            size_t errors = 0;
+            for(double x : X){
+                errors += (B.pos(x) != V.pos(x));
+            }
+            // exact nodes: last i with X[i] <= x
+            for(size_t j=0;j<1000;++j){
+                errors += (B.pos((*nodes)[j]) != j);
+            }
+            TEST(errors,0);
+        }
+    }
+
+    grob::GridBucket<double> B(0.0,1.0,5);
+    PVAR(B);
+    TEST(B.pos(0.3),1);
+    TEST(B.pos(2.0),3);
+    TEST(B.pos(-1.0),0);
+    TEST(B.contains(1.1),false);
+    grob::GridBucket<double> B2{1.0,1.0};
+    TEST(B2.pos(1.0),0);
+
+    grob::GridBucketHisto<double> BH(std::vector<double>{0,1,3,7});
+    PVAR(BH);
+    TEST(BH.pos(2.0),1);
+    return 0;
+}
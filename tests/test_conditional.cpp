@@ -0,0 +1,131 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/conditional_sampler.hpp"
+#include "../include/grob/integral.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(3 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = t*t;
+    }
+    return nodes;
+}
+
+/// @return max over boxes of 4^Dim partition of unit cube of |count - expected|/sqrt(expected),
+/// expected numbers are midpoint sums of density F on fine grid
+template <size_t Dim,typename FuncType,typename PointsType>
+double box_deviation(FuncType const & F,PointsType const & X,size_t fine){
+    constexpr size_t B = 4;
+    size_t nb = 1;
+    for(size_t e=0;e<Dim;++e){
+        nb *= B;
+    }
+    auto box = [&](std::array<double,Dim> const & x){
+        size_t b = 0;
+        for(size_t e=0;e<Dim;++e){
+            b = b*B + std::min(size_t(x[e]*B),B - 1);
+        }
+        return b;
+    };
+    std::vector<double> expected(nb,0),counts(nb,0);
+    size_t nf = 1;
+    for(size_t e=0;e<Dim;++e){
+        nf *= fine;
+    }
+    double sum = 0;
+    for(size_t l=0;l<nf;++l){
+        std::array<double,Dim> x;
+        size_t r = l;
+        for(size_t e=Dim;e-- > 0;){
+            x[e] = (r % fine + 0.5)/fine;
+            r /= fine;
+        }
+        double f = std::apply([&](auto...c){return F(c...);},x);
+        expected[box(x)] += f;
+        sum += f;
+    }
+    for(auto const & P : X){
+        std::array<double,Dim> x;
+        if constexpr (Dim == 1){
+            x[0] = P;
+        } else {
+            std::apply([&](auto...c){x = {double(c)...};},P.as_tuple());
+        }
+        counts[box(x)] += 1;
+    }
+    double dev = 0;
+    for(size_t b=0;b<nb;++b){
+        double e = expected[b]*X.size()/sum;
+        dev = std::max(dev,std::abs(counts[b] - e)/std::sqrt(e));
+    }
+    return dev;
+}
+
+int main(){
+    std::mt19937_64 gen(42);
+    const size_t n = 1 << 20;
+
+    // 1-dim: fraction of points below x is normalized antiderivative
+    auto F1 = grob::make_function_f(grob::GridVector<double>(inner_nodes(4)),[](double x){return 0.2 + x*(1-x);});
+    auto S1 = grob::make_conditional_sampler(F1);
+    auto I1 = grob::make_integral_index(F1);
+    TEST(std::abs(S1.total() - I1.total()) < 1e-12,true);
+    std::vector<double> X1(n);
+    S1.sample_n(gen,X1);
+    double dev = 0;
+    for(double x : {0.1,0.3,0.5,0.77,0.9}){
+        double p = I1.antiderivative(x)/I1.total();
+        double c = std::count_if(X1.begin(),X1.end(),[x](double y){return y < x;});
+        dev = std::max(dev,std::abs(c - n*p)/std::sqrt(n*p*(1-p)));
+    }
+    TEST(dev < 5,true);
+    TEST(std::abs(grob::make_conditional_sampler(
+        grob::make_function_f(grob::GridUniform<double>(0,1,2),[](double x){return x;}))(gen) - 0.5) <= 0.5,true);
+
+    // 2-dim ragged grid: inner grids with the same range, density is interpolation itself
+    auto f2 = [](auto const & P){auto [x,y] = P;return 0.1 + x*y + std::sin(3*y)*std::sin(3*y)*x;};
+    auto G2 = grob::make_grid_f(grob::GridUniform<double>(0,1,11),[](size_t i){return grob::GridVector<double>(inner_nodes(i));});
+    auto F2 = grob::make_function_f(G2,f2);
+    auto S2 = grob::make_conditional_sampler(F2);
+    std::vector<decltype(S2)::value_type> X2(n);
+    S2.sample_n(gen,X2);
+    TEST(box_deviation<2>(F2,X2,400) < 5,true);
+
+    // 3-dim mesh and rectilinear grids
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x + y*z*z + 0.05;};
+    auto G3m = grob::mesh_grids(grob::GridUniform<double>(0,1,6),
+        grob::mesh_grids(grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,4)));
+    auto F3 = grob::make_function_f(G3m,f3);
+    auto S3 = grob::make_conditional_sampler(F3);
+    std::vector<decltype(S3)::value_type> X3(n);
+    S3.sample_n(gen,X3);
+    TEST(box_deviation<3>(F3,X3,80) < 5,true);
+    auto F3R = grob::make_function_f(grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,6),
+        grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,4)),f3);
+    auto S3R = grob::make_conditional_sampler(F3R);
+    S3R.sample_n(gen,X3);
+    TEST(box_deviation<3>(F3R,X3,80) < 5,true);
+
+    // wrong densities
+    bool thrown = false;
+    try{
+        grob::make_conditional_sampler(grob::make_function_f(G2,[](auto const & P){return std::get<1>(P) - 0.5;}));
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    thrown = false;
+    try{
+        grob::make_conditional_sampler(grob::make_function_f(G2,[](auto const &){return 0.0;}));
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @return max |F(x) - G(x)| on xs
+template <typename F1,typename F2>
+double max_diff(F1 const & F,F2 const & G,std::vector<double> const & xs){
+    double diff = 0;
+    for(double x : xs){
+        diff = std::max(diff,std::abs(F(x) - G(x)));
+    }
+    return diff;
+}
+
+/// @return max jump of second derivative by x between neighbour cells
+template <typename FuncType>
+double c2_jump(FuncType const & F){
+    double jump = 0;
+    for(size_t i=1;i+1<F.Grid.size();++i){
+        const double * l = F.Values.cell(i-1);
+        const double * r = F.Values.cell(i);
+        double hl = F.Grid[i] - F.Grid[i-1],hr = F.Grid[i+1] - F.Grid[i];
+        jump = std::max(jump,std::abs((2*l[2] + 6*l[3])/(hl*hl) - 2*r[2]/(hr*hr)));
+    }
+    return jump;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.2,1.2);
+    std::vector<double> X(10000);
+    for(auto & x : X){
+        x = dist(gen);
+    }
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+    const double eps = 1e-12;
+
+    // hermite spline is the same function as interpolator_spline1D, also outside of grid
+    for(size_t M : {2,3,4,5,100}){
+        auto FU = grob::make_function_f<grob::spline1D>(grob::GridUniform<double>(0,1,M),f);
+        auto SU = grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),f);
+        TEST(max_diff(FU,SU,X) < eps,true);
+        auto FV = grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes(M)),f);
+        auto SV = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),f);
+        TEST(max_diff(FV,SV,X) < eps,true);
+        auto DV = grob::make_spline_function_f<grob::interpolator_cubic_spline_diff>(grob::GridVector<double>(nodes(M)),f);
+        TEST(max_diff(SV,[&](double x){return DV(x).first;},X) < eps,true);
+    }
+
+    // derivative is derivative of value
+    auto DV = grob::make_spline_function_f<grob::interpolator_cubic_spline_diff>(grob::GridVector<double>(nodes(50)),f);
+    double diff = 0;
+    for(size_t k=0;k<1000;++k){
+        double x = X[k],dx = 1e-6;
+        diff = std::max(diff,std::abs(DV(x).second - (DV(x+dx).first - DV(x-dx).first)/(2*dx)));
+    }
+    TEST(diff < 1e-5,true);
+
+    // natural spline: linear functions are exact, zero second derivative at ends, C2
+    auto NL = grob::make_spline_function_f(grob::GridVector<double>(nodes(20)),[](double x){return 1 - 2*x;},
+        grob::spline_kind::natural);
+    TEST(max_diff(NL,[](double x){return 1 - 2*x;},X) < eps,true);
+    auto NS = grob::make_spline_function_f(grob::GridVector<double>(nodes(20)),f,grob::spline_kind::natural);
+    const double * last = NS.Values.cell(NS.Grid.size() - 2);
+    TEST(std::abs(NS.Values.cell(0)[2]) < eps && std::abs(last[2] + 3*last[3]) < 1e-10,true);
+    TEST(c2_jump(NS) < 1e-8,true);
+    TEST(NS(NS.Grid[7]),f(NS.Grid[7]));
+
+    // clamped spline with exact end derivatives reproduces cubic
+    auto cubic = [](double x){return x*x*x - 2*x*x + 0.5*x + 1;};
+    for(size_t M : {2,3,20}){
+        auto CS = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),cubic,grob::spline_kind::clamped,0.5,-0.5);
+        TEST(max_diff(CS,cubic,X) < 1e-10,true);
+    }
+    auto CU = grob::make_spline_function_f(grob::GridUniform<double>(0,1,50),f,grob::spline_kind::clamped,5.0,5*std::cos(5.0) + 2);
+    TEST(c2_jump(CU) < 1e-8,true);
+    std::vector<double> inside;
+    for(double x : X){
+        if(0 <= x && x <= 1)
+            inside.push_back(x);
+    }
+    TEST(max_diff(CU,f,inside) < 1e-4,true);
+
+    // batch evaluation
+    auto SB = grob::make_spline_function_f(grob::GridVector<double>(nodes(100)),f,grob::spline_kind::natural);
+    std::vector<double> out(X.size());
+    SB.eval_batch(X.data(),X.size(),out.data());
+    diff = 0;
+    for(size_t k=0;k<X.size();++k){
+        diff = std::max(diff,std::abs(out[k] - SB(X[k])));
+    }
+    TEST(diff < eps,true);
+
+    // wrong sizes
+    bool thrown = false;
+    try{
+        grob::spline_values<double> bad(grob::GridUniform<double>(0,1,5),std::vector<double>(4));
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    return 0;
+}
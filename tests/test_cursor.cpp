@@ -0,0 +1,97 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/multigrid.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+int main(){
+    const size_t N = 100000;
+    std::vector<double> nodes(N);
+    for(size_t i=0;i<N;++i){
+        double t = i/(N-1.0);
+        nodes[i] = t*t*t;
+    }
+    grob::GridVector<double> V(nodes);
+
+    // random walk with small steps
+    std::mt19937 gen(42);
+    std::normal_distribution<double> step(0,1e-4);
+    std::vector<double> X(1 << 20);
+    double x = 0.5;
+    for(auto & xi : X){
+        x += step(gen);
+        x = (x < -0.1 ? -0.1 : (x > 1.1 ? 1.1 : x));
+        xi = x;
+    }
+    X[100] = NAN;
+
+    size_t errors = 0;
+    auto C = V.cursor();
+    for(double xi : X){
+        errors += (C.locate(xi) != V.pos(xi));
+    }
+    TEST(errors,0);
+
+    // far jumps and any hint
+    errors = 0;
+    for(size_t hint : {size_t(0),size_t(1),N/2,N-2,N-1,N+10}){
+        for(double xi : {-1.0,0.001,0.3,0.99,2.0,(double)NAN}){
+            errors += (V.pos_hint(hint,xi) != V.pos(xi));
+        }
+    }
+    TEST(errors,0);
+
+    // exact nodes: hinted search gives last i with X[i] <= x from any hint,
+    // pos gives one of two cells, adjacent to node
+    errors = 0;
+    for(size_t hint : {size_t(0),N/2,N-1}){
+        for(size_t j=0;j<N;j += 7){
+            errors += (V.pos_hint(hint,nodes[j]) != std::min(j,N-2));
+        }
+    }
+    TEST(errors,0);
+    errors = 0;
+    for(size_t j=0;j<N;++j){
+        size_t i = V.pos(nodes[j]);
+        errors += !(nodes[i] <= nodes[j] && nodes[j] <= nodes[i+1]);
+    }
+    TEST(errors,0);
+
+    grob::GridVectorHisto<double> VH(nodes);
+    TEST(VH.pos_hint(10,0.3),VH.pos(0.3));
+
+    grob::GridUniform<double> U(0,1,11);
+    TEST(U.pos_hint(7,0.35),3);
+
+    auto F = grob::make_func_grid(1.0,100.0,11,
+                [](double x){return std::log(x);},[](double x){return std::exp(x);});
+    TEST(F.pos_hint(2,50.0),F.pos(50.0));
+
+    // ragged MultiGrid
+    auto G2 = grob::make_grid_f(grob::GridUniform<double>(0,1,11),[](size_t i){
+        std::vector<double> inner(10 + 10*i);
+        for(size_t j=0;j<inner.size();++j)
+            inner[j] = j/(inner.size() - 1.0);
+        return grob::GridVector<double>(inner);
+    });
+    auto C2 = G2.cursor();
+    errors = 0;
+    for(size_t k=0;k<1000;++k){
+        double t = k/1000.0;
+        auto mi = C2.locate(t,std::sin(10*t)*std::sin(10*t));
+        auto mi_exp = G2.pos(t,std::sin(10*t)*std::sin(10*t));
+        errors += (mi.i != mi_exp.i || mi.m.i != mi_exp.m.i);
+    }
+    TEST(errors,0);
+    PVAR(C2.index());
+
+    // 3D
+    auto G3 = grob::mesh_grids(grob::GridUniform<double>(0,1,5),G2);
+    auto C3 = G3.cursor();
+    auto mi3 = C3.locate_tuple(std::make_tuple(0.3,0.55,0.42));
+    TEST(mi3,G3.pos(0.3,0.55,0.42));
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/csv_io.hpp"
+#include <vector>
+#include <sstream>
+#include <cmath>
+
+template <typename GridType>
+size_t check_grid(GridType const & G){
+    size_t errors = 0;
+    size_t count = 0;
+    for(auto [MI,i,X] : G.enumerate()){
+        errors += (G.LinearIndex(MI) != i) + (i != count) + !(G[MI] == X);
+        ++count;
+    }
+    errors += (count != G.size());
+    return errors;
+}
+
+int main(){
+    grob::GridVector<double> G1(std::vector<double>{0,0.1,0.5,1});
+    auto G2 = grob::make_grid_f(grob::GridUniform<double>(0,1,11),[](size_t i){
+        return grob::GridUniform<double>(-0.1*i,1 + 0.1*i,5 + i);
+    });
+    auto G3 = grob::mesh_grids(grob::GridUniform<double>(-1,1,9),G2);
+    auto R3 = grob::make_rectilinear_grid(grob::GridUniform<double>(-1,1,9),G1,
+                grob::GridUniform<double>(0,2,7));
+    TEST(check_grid(G1),0);
+    TEST(check_grid(G2),0);
+    TEST(check_grid(G3),0);
+    TEST(check_grid(R3),0);
+    // inner grids given by value
+    auto GP = grob::make_grid_packed(grob::GridUniform<double>(0,1,7),[](size_t i){
+        return std::vector<double>{0,0.5 + 0.1*i,2};
+    });
+    auto GU = grob::make_grid_uniform_rows(grob::GridUniform<double>(0,1,7),[](size_t i){
+        return grob::GridUniform<double>(0,1 + i,3 + i);
+    });
+    TEST(check_grid(GP),0);
+    TEST(check_grid(GU),0);
+    TEST(check_grid(grob::mesh_grids(grob::GridUniform<double>(-1,1,3),GP)),0);
+
+    // ranges, starting inside of row
+    size_t errors = 0;
+    for(size_t begin : {size_t(0),size_t(3),size_t(17),G3.size() - 1}){
+        size_t count = begin;
+        for(auto [MI,i,X] : grob::GridEnumerator<decltype(G3)>(G3,{begin,G3.size(),G3.FromLinear(begin)})){
+            errors += (G3.LinearIndex(MI) != i) + (i != count) + !(G3[MI] == X);
+            ++count;
+        }
+        errors += (count != G3.size());
+    }
+    TEST(errors,0);
+
+    // values by reference
+    auto F = grob::make_function_f<grob::interProd<grob::linear_interpolator,grob::linear_interpolator>>(G2,
+                [](auto const & P){auto [x,y] = P;return x*y;});
+    for(auto [MI,i,X,V] : F.enumerate()){
+        V *= 2;
+    }
+    errors = 0;
+    for(auto [MI,i,X,V] : std::as_const(F).enumerate()){
+        auto [x,y] = X;
+        errors += (V != 2*x*y) + (&V != &F.Values[F.Grid.LinearIndex(MI)]);
+    }
+    TEST(errors,0);
+
+    F.map([](auto const & P){auto [x,y] = P;return x + y;});
+    F.map_pack([](double x,double y){return x - y;});
+    errors = 0;
+    for(auto [MI,i,X,V] : F.enumerate()){
+        auto [x,y] = X;
+        errors += (V != x - y);
+    }
+    TEST(errors,0);
+
+    // csv export
+    std::stringstream S;
+    grob::as_csv(F).save(S);
+    size_t lines = 0;
+    for(std::string line;std::getline(S,line);){
+        ++lines;
+    }
+    TEST(lines,F.size());
+
+    return 0;
+}
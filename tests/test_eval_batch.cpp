@@ -0,0 +1,76 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+/// @return max difference between eval_batch and eval on points xs
+template <typename FuncType,typename PointsType>
+double max_diff(FuncType const & F,PointsType const & X){
+    std::vector<double> out(X.size());
+    F.eval_batch(X.data(),X.size(),out.data());
+    double diff = 0;
+    for(size_t k=0;k<X.size();++k){
+        diff = std::max(diff,std::abs(out[k] - F.eval(X[k])));
+    }
+    return diff;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 10000;
+    std::vector<double> xs(N);
+    for(auto & x : xs){
+        x = dist(gen);
+    }
+    const double eps = 1e-12;
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+
+    // 1-dim, small grids (all stencils near boundary) and large grids
+    for(size_t M : {2,3,4,5,1000}){
+        std::vector<double> nodes(M);
+        for(size_t i=0;i<M;++i){
+            nodes[i] = std::pow(i/(M - 1.0),1.5);
+        }
+        TEST(max_diff(grob::make_function_f<grob::linear_interpolator>(grob::GridUniform<double>(0,1,M),f),xs) < eps,true);
+        TEST(max_diff(grob::make_function_f<grob::linear_interpolator>(grob::GridVector<double>(nodes),f),xs) < eps,true);
+        TEST(max_diff(grob::make_function_f<grob::spline1D>(grob::GridUniform<double>(0,1,M),f),xs) < eps,true);
+        TEST(max_diff(grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes),f),xs) < eps,true);
+    }
+
+    // interpolator without batch kernel
+    auto FD = grob::make_function_f<grob::splineD1D>(grob::GridUniform<double>(0,1,100),f);
+    std::vector<decltype(FD(0.0))> out_d(100);
+    FD.eval_batch(xs.data(),100,out_d.data());
+    double diff = 0;
+    for(size_t k=0;k<100;++k){
+        auto [v,d] = FD(xs[k]);
+        diff = std::max({diff,std::abs(out_d[k].first - v),std::abs(out_d[k].second - d)});
+    }
+    TEST(diff < eps,true);
+
+    // N-dim: points and coordinate arrays
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    auto F3 = grob::make_function_f(grob::make_grid_f(grob::GridUniform<double>(0,1,41),
+        [](size_t i){return grob::mesh_grids(grob::GridUniform<double>(0,1 + 0.01*i,5 + i),grob::GridUniform<double>(0,1,31));}),f3);
+    std::vector<grob::Point<double,double,double>> X3(N);
+    std::vector<double> ys(X3.size()),zs(X3.size());
+    for(size_t k=0;k<X3.size();++k){
+        ys[k] = dist(gen);
+        zs[k] = dist(gen);
+        X3[k] = grob::make_point(xs[k],ys[k],zs[k]);
+    }
+    TEST(max_diff(F3,X3) < eps,true);
+    std::vector<double> out3(X3.size());
+    F3.eval_batch(std::array<const double *,3>{xs.data(),ys.data(),zs.data()},X3.size(),out3.data());
+    diff = 0;
+    for(size_t k=0;k<X3.size();++k){
+        diff = std::max(diff,std::abs(out3[k] - F3.eval(X3[k])));
+    }
+    TEST(diff < eps,true);
+    return 0;
+}
@@ -0,0 +1,66 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+template <typename T>
+size_t count_mismatches(std::vector<T> const & nodes,std::vector<T> const & X){
+    grob::GridVector<T> V(nodes);
+    grob::GridEytzinger<T> E(nodes);
+    std::vector<size_t> out(X.size());
+    E.pos_batch(X.data(),X.size(),out.data());
+    size_t errors = 0;
+    for(size_t i=0;i<X.size();++i){
+        if(E.pos(X[i]) != V.pos(X[i]) || out[i] != V.pos(X[i]))
+            ++errors;
+    }
+    return errors;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+
+    std::vector<double> X(1 << 16);
+    for(auto & x : X){
+        x = dist(gen);
+    }
+    X[3] = X[17] = NAN;
+
+    for(size_t N : {2,3,4,5,7,8,9,15,16,17,100,1023,1024,1025}){
+        std::vector<double> nodes(N);
+        for(size_t i=0;i<N;++i){
+            double t = i/(N-1.0);
+            nodes[i] = t*t;
+        }
+        TEST(count_mismatches(nodes,X),0);
+
+        // on nodes result is always the last i with X[i] <= x
+        grob::GridEytzinger<double> E(nodes);
+        std::vector<size_t> out(N);
+        E.pos_batch(nodes.data(),N,out.data());
+        size_t errors = 0;
+        for(size_t j=0;j<N;++j){
+            size_t expected = std::min(j,N-2);
+            errors += (E.pos(nodes[j]) != expected) + (out[j] != expected);
+        }
+        TEST(errors,0);
+    }
+    TEST(count_mismatches(std::vector<float>{0.1f,0.5f,0.6f,0.9f},
+            std::vector<float>{0.f,0.1f,0.3f,0.5f,0.55f,0.6f,0.9f,1.0f,NAN}),0);
+
+    grob::GridEytzinger<double> E(0.0,1.0,5);
+    PVAR(E);
+    TEST(E.pos(0.3),1);
+    TEST(E.contains(1.1),false);
+
+    grob::GridEytzingerHisto<double> EH(std::vector<double>{0,1,3,7});
+    PVAR(EH);
+    TEST(EH.pos(2.0),1);
+    TEST(EH.size(),3);
+    return 0;
+}
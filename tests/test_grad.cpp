@@ -0,0 +1,127 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+/// @return max deviation of eval_grad from eval and from central differences of eval
+template <typename FuncType,typename PointsType>
+std::pair<double,double> grad_error(FuncType const & F,PointsType const & X){
+    constexpr size_t Dim = FuncType::Dim;
+    const double dx = 1e-6;
+    double dv = 0,dg = 0;
+    for(auto const & P : X){
+        auto [v,g] = F.eval_grad(P);
+        dv = std::max(dv,std::abs(v - F.eval(P)));
+        std::array<double,Dim> gs;
+        std::apply([&](auto const &...c){gs = {double(c)...};},g.as_tuple());
+        for(size_t e=0;e<Dim;++e){
+            auto tp = P.as_tuple(),tm = P.as_tuple();
+            std::apply([&](auto &...c){size_t j=0;((c += (j++ == e ? dx : 0)),...);},tp);
+            std::apply([&](auto &...c){size_t j=0;((c -= (j++ == e ? dx : 0)),...);},tm);
+            double fd = (F.eval(grob::make_point_tuple(tp)) - F.eval(grob::make_point_tuple(tm)))/(2*dx);
+            dg = std::max(dg,std::abs(gs[e] - fd));
+        }
+    }
+    return {dv,dg};
+}
+
+int main(){
+    std::mt19937 gen(42);
+    // points are kept off grid nodes, where finite differences of piecewise functions are meaningless
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    auto f1 = [](double x){return std::sin(5*x) + x*x;};
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(3*y);};
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    const double eps = 1e-12;
+
+    // 1-dim: the same as splineD1D, linear gradient is slope of cell
+    for(size_t M : {2,3,4,5,30}){
+        auto GU = grob::GridUniform<double>(0,1,M);
+        auto GV = grob::GridVector<double>(inner_nodes(M + 1));
+        auto SU = grob::make_function_f<grob::spline1D>(GU,f1);
+        auto DU = grob::make_function_f<grob::splineD1D>(GU,f1);
+        auto SV = grob::make_function_f<grob::spline1D>(GV,f1);
+        auto DV = grob::make_function_f<grob::splineD1D>(GV,f1);
+        auto LV = grob::make_function_f<grob::linear_interpolator>(GV,f1);
+        double diff = 0;
+        for(size_t k=0;k<1000;++k){
+            double x = dist(gen);
+            auto [vu,gu] = SU.eval_grad(x);
+            auto [vv,gv] = SV.eval_grad(x);
+            diff = std::max({diff,std::abs(vu - DU(x).first),std::abs(double(gu) - DU(x).second),
+                            std::abs(vv - DV(x).first),std::abs(double(gv) - DV(x).second)});
+            size_t i = GV.pos(x);
+            auto [vl,gl] = LV.eval_grad(x);
+            diff = std::max({diff,std::abs(vl - LV(x)),
+                std::abs(double(gl) - (LV.Values[i+1] - LV.Values[i])/(GV[i+1] - GV[i]))});
+        }
+        TEST(diff < 1e-9,true);
+    }
+
+    std::vector<grob::Point<double,double>> X2(1000);
+    for(auto & P : X2){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    std::vector<grob::Point<double,double,double>> X3(1000);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+
+    // 2-dim and 3-dim: regular, ragged and rectilinear grids
+    auto G2m = grob::mesh_grids(grob::GridUniform<double>(0,1,21),grob::GridVector<double>(inner_nodes(5)));
+    auto G2r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),[](size_t i){return grob::GridVector<double>(inner_nodes(i));});
+    auto G3m = grob::mesh_grids(grob::GridUniform<double>(0,1,21),
+        grob::mesh_grids(grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,17)));
+    auto G3r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        });
+    auto G3R = grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,21),
+        grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,17));
+    typedef grob::interProd<grob::spline1D,grob::spline1D> S2;
+    typedef grob::interProd3<grob::spline1D,grob::spline1D,grob::spline1D> S3;
+    typedef grob::interProd3<grob::spline1D,grob::linear_interpolator,grob::spline1D> SLS;
+    auto check = [&](auto const & F,auto const & X){
+        auto [dv,dg] = grad_error(F,X);
+        TEST(dv < eps,true);
+        TEST(dg < 1e-5,true);
+    };
+    check(grob::make_function_f(G2m,f2),X2);
+    check(grob::make_function_f(G2r,f2),X2);
+    check(grob::make_function_f<S2>(G2m,f2),X2);
+    check(grob::make_function_f<S2>(G2r,f2),X2);
+    check(grob::make_function_f(G3m,f3),X3);
+    check(grob::make_function_f(G3r,f3),X3);
+    check(grob::make_function_f(G3R,f3),X3);
+    check(grob::make_function_f<S3>(G3m,f3),X3);
+    check(grob::make_function_f<S3>(G3r,f3),X3);
+    check(grob::make_function_f<S3>(G3R,f3),X3);
+    check(grob::make_function_f<SLS>(G3r,f3),X3);
+
+    // interpolator_grad as policy of GridFunction
+    auto FG = grob::make_function_f<grob::interGrad<S3>>(G3m,f3);
+    auto FS = grob::make_function_f<S3>(G3m,f3);
+    double diff = 0;
+    for(auto const & P : X3){
+        auto [v,g] = FG(P);
+        auto [v1,g1] = FS.eval_grad(P);
+        diff = std::max({diff,std::abs(v - v1),std::abs(g.template get<0>() - g1.template get<0>()),
+                        std::abs(g.template get<2>() - g1.template get<2>())});
+    }
+    TEST(diff < eps,true);
+    return 0;
+}
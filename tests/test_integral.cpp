@@ -0,0 +1,114 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/integral.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @brief integral of F from a to b by Gauss-Legendre (3 points) over cells of grid,
+/// exact for piecewise polynomials up to degree 5
+template <typename FuncType,typename GridType>
+double gauss(FuncType const & F,GridType const & grid,double a,double b){
+    const double g = std::sqrt(0.6);
+    double sum = 0;
+    for(size_t i=0;i+1<grid.size();++i){
+        double l = std::max(a,double(grid[i])),r = std::min(b,double(grid[i+1]));
+        if(l >= r)
+            continue;
+        double c = (l + r)/2,h = (r - l)/2;
+        sum += h*(5*F(c - g*h) + 8*F(c) + 5*F(c + g*h))/9;
+    }
+    return sum;
+}
+
+/// @return max error of integrals over random intervals
+template <typename IndexType,typename FuncType,typename GridType>
+double max_error(IndexType const & I,FuncType const & F,GridType const & grid,std::vector<double> const & xs){
+    double err = 0;
+    for(size_t k=0;k+1<xs.size();k += 2){
+        double a = std::min(xs[k],xs[k+1]),b = std::max(xs[k],xs[k+1]);
+        err = std::max(err,std::abs(I.integral(a,b) - gauss(F,grid,a,b)));
+    }
+    return err;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    std::vector<double> xs(2000);
+    for(auto & x : xs){
+        x = dist(gen);
+    }
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+    const double eps = 1e-12;
+
+    // exact for linear, spline1D and precomputed cubic splines on uniform and vector grids
+    for(size_t M : {2,3,4,50}){
+        auto GU = grob::GridUniform<double>(0,1,M);
+        auto GV = grob::GridVector<double>(nodes(M));
+        auto FL = grob::make_function_f(GV,f);
+        auto FS = grob::make_function_f<grob::spline1D>(GU,f);
+        auto FSV = grob::make_function_f<grob::spline1D>(GV,f);
+        auto FC = grob::make_spline_function_f(GV,f,grob::spline_kind::natural);
+        auto FP = grob::make_spline_function_f(GU,f,grob::spline_kind::pchip);
+        TEST(max_error(grob::make_integral_index(FL),FL,GV,xs) < eps,true);
+        TEST(max_error(grob::make_integral_index(FS),FS,GU,xs) < eps,true);
+        TEST(max_error(grob::make_integral_index(FSV),FSV,GV,xs) < eps,true);
+        TEST(max_error(grob::make_integral_index(FC),FC,GV,xs) < eps,true);
+        TEST(max_error(grob::make_integral_index(FP),FP,GU,xs) < eps,true);
+    }
+
+    // clamping to grid range, orientation and total
+    auto FL = grob::make_function_f(grob::GridVector<double>(nodes(50)),f);
+    auto IL = grob::make_integral_index(FL);
+    TEST(std::abs(IL.integral(-1,2) - IL.total()) < eps,true);
+    TEST(std::abs(IL.integral(0.7,0.2) + IL.integral(0.2,0.7)) < eps,true);
+    TEST(IL.antiderivative(-1),0);
+    TEST(std::abs(IL.total() - gauss(FL,FL.Grid,0,1)) < eps,true);
+
+    // antiderivative as GridFunction: exact for linear function
+    auto AL = IL.antiderivative_function();
+    double diff = 0;
+    for(double x : xs){
+        diff = std::max(diff,std::abs(AL(x) - IL.antiderivative(x)));
+    }
+    TEST(diff < eps,true);
+    auto IS = grob::make_integral_index(grob::make_function_f<grob::spline1D>(grob::GridUniform<double>(0,1,50),f));
+    auto AS = IS.antiderivative_function();
+    diff = 0;
+    for(double x : xs){
+        diff = std::max(diff,std::abs(AS(x) - IS.antiderivative(x)));
+    }
+    // antiderivative of cubic is quartic: Hermite error is about h^4*max|f'''|/384
+    TEST(diff < 1e-6,true);
+
+    // histograms: bins are spread uniformly
+    auto H = grob::make_histo<double>(grob::GridVectorHisto<double>(nodes(21)));
+    for(size_t k=0;k<10000;++k){
+        H.put(1.0,dist(gen));
+    }
+    auto IH = grob::make_integral_index(H);
+    TEST(IH.total(),10000);
+    double in_bins = 0;
+    for(size_t i=3;i<8;++i){
+        in_bins += H.Values[i];
+    }
+    TEST(std::abs(IH.integral(H.Grid[3].left,H.Grid[7].right) - in_bins) < 1e-9,true);
+    TEST(std::abs(IH.integral(H.Grid[5].left,(H.Grid[5].left + H.Grid[5].right)/2) - H.Values[5]/2) < 1e-9,true);
+    auto AH = IH.antiderivative_function();
+    TEST(std::abs(AH(H.Grid[7].right) - IH.antiderivative(H.Grid[7].right)) < 1e-9,true);
+    auto HU = grob::make_histo<double>(grob::GridUniformHisto<double>(0,1,11));
+    HU.Values[4] = 2;
+    TEST(std::abs(grob::make_integral_index(HU).integral(0.35,0.45) - 1) < eps,true);
+    return 0;
+}
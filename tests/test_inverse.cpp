@@ -0,0 +1,101 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/inverse.hpp"
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @return max |F(G(y)) - y| over ys
+template <typename F1,typename F2>
+double round_trip(F1 const & F,F2 const & G,std::vector<double> const & ys){
+    double diff = 0;
+    for(double y : ys){
+        diff = std::max(diff,std::abs(F(G(y)) - y));
+    }
+    return diff;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    const double eps = 1e-12;
+    auto f = [](double x){return x*x*x + x + 1;};
+    auto g = [](double x){return std::exp(-3*x);};
+    std::vector<double> yf(10000),yg(10000);
+    for(size_t k=0;k<yf.size();++k){
+        double x = dist(gen);
+        yf[k] = f(x);
+        yg[k] = g(x);
+    }
+
+    // inverse on own nodes is exact for linear interpolation, increasing and decreasing
+    auto FL = grob::make_function_f(grob::GridVector<double>(nodes(50)),f);
+    auto IL = grob::inverse(FL);
+    TEST(round_trip(FL,IL,yf) < eps,true);
+    TEST(IL(FL.Values[7]),FL.Grid[7]);
+    auto GL = grob::make_function_f(grob::GridUniform<double>(0,1,50),g);
+    auto IG = grob::inverse(GL);
+    TEST(round_trip(GL,IG,yg) < eps,true);
+
+    // uniform value grid: nodes are exact solutions, for linear segments too
+    auto UL = grob::inverse(FL,200);
+    double diff = 0;
+    for(size_t k=0;k<UL.Grid.size();++k){
+        diff = std::max(diff,std::abs(FL(UL.Values[k]) - UL.Grid[k]));
+    }
+    TEST(diff < eps,true);
+    TEST(round_trip(FL,UL,yf) < 1e-3,true);
+    auto UG = grob::inverse(GL,200);
+    TEST(UG.Grid.front() < UG.Grid.back(),true);
+    diff = 0;
+    for(size_t k=0;k<UG.Grid.size();++k){
+        diff = std::max(diff,std::abs(GL(UG.Values[k]) - UG.Grid[k]));
+    }
+    TEST(diff < eps,true);
+
+    // spline functions: nodes up to tolerance, spline inverse on dense grid
+    auto FS = grob::make_function_f<grob::spline1D>(grob::GridVector<double>(nodes(30)),f);
+    auto US = grob::inverse<grob::spline1D>(FS,1000);
+    diff = 0;
+    for(size_t k=0;k<US.Grid.size();++k){
+        diff = std::max(diff,std::abs(FS(US.Values[k]) - US.Grid[k]));
+    }
+    TEST(diff < 1e-10,true);
+    TEST(round_trip(FS,US,yf) < 1e-6,true);
+    auto CS = grob::make_spline_function_f(grob::GridLog<double>(1e-3,1e3,40),
+        [](double x){return std::log(1 + x);},grob::spline_kind::pchip);
+    auto UC = grob::inverse<grob::spline1D>(CS,2000);
+    std::vector<double> yc(1000);
+    for(auto & y : yc){
+        y = std::log(1 + std::exp(std::log(1e-3) + dist(gen)*std::log(1e6)));
+    }
+    TEST(round_trip(CS,UC,yc) < 1e-4,true);
+
+    // not monotone and small inverse grids
+    bool thrown = false;
+    try{
+        grob::inverse(grob::make_function_f(grob::GridUniform<double>(-1,1,11),[](double x){return x*x;}));
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    thrown = false;
+    try{
+        grob::inverse(FL,1);
+    }catch(std::invalid_argument const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    return 0;
+}
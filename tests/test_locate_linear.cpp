@@ -0,0 +1,73 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+template <typename GridType,typename...Args>
+size_t old_linear(GridType const & G,bool & b,Args const&...args){
+    auto bMI = G.spos(args...);
+    b = std::get<0>(bMI);
+    return b ? G.LinearIndex(std::get<1>(bMI)) : 0;
+}
+
+int main(){
+    // ragged 2D inner grids
+    auto G2 = grob::make_grid_f(grob::GridUniformHisto<double>(0,1,11),[](size_t i){
+        return grob::GridUniformHisto<double>(-0.1*i,1 + 0.1*i,5 + i);
+    });
+    auto G3 = grob::mesh_grids(grob::GridUniformHisto<double>(-1,1,9),G2);
+    PVAR(G3.size());
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.2,2.2);
+    const size_t N = 1 << 16;
+    std::vector<grob::Point<double,double,double>> X(N);
+    for(auto & P : X){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    X[1] = grob::make_point(0.5,NAN,0.5);
+    X[2] = grob::make_point(1.0,1.0,1.0);
+
+    size_t errors = 0;
+    size_t inside = 0;
+    for(auto const & P : X){
+        bool b;
+        size_t li_old = old_linear(G3,b,std::get<0>(P),std::get<1>(P),std::get<2>(P));
+        auto li = G3.locate_linear_tuple(P.as_tuple());
+        errors += (b != li.has_value()) || (b && li_old != *li);
+        inside += b;
+    }
+    TEST(errors,0);
+    PVAR(inside);
+    TEST(G3.locate_linear(0.1,0.2,0.3).has_value(),true);
+    TEST(G3.locate_linear(5.0,0.2,0.3).has_value(),false);
+
+    // 1D
+    grob::GridVectorHisto<double> G1(std::vector<double>{0,0.1,0.5,1});
+    TEST(G1.locate_linear(0.3).value(),1);
+    TEST(G1.locate_linear(-0.3).has_value(),false);
+
+    // histogram fill
+    auto H = grob::make_histo<double>(G3);
+    auto H_old = grob::make_histo<double>(G3);
+    size_t inside_new = 0;
+    for(auto const & P : X){
+        inside_new += H.put_point(1.0,P);
+    }
+    size_t inside_old = 0;
+    for(auto const & P : X){
+        bool b;
+        size_t li = old_linear(H_old.Grid,b,std::get<0>(P),std::get<1>(P),std::get<2>(P));
+        if(b){
+            H_old.Values[li] += 1.0;
+            ++inside_old;
+        }
+    }
+    TEST(inside_new,inside_old);
+    TEST(H.Values == H_old.Values,true);
+    return 0;
+}
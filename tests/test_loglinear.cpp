@@ -0,0 +1,102 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+template <typename GridType,typename T>
+size_t count_batch_errors(GridType const & G,std::vector<T> const & X){
+    std::vector<size_t> out(X.size());
+    G.pos_batch(X.data(),X.size(),out.data());
+    size_t errors = 0;
+    for(size_t k=0;k<X.size();++k){
+        errors += (out[k] != G.pos(X[k]));
+    }
+    return errors;
+}
+
+template <typename GridType,typename T>
+size_t count_errors(GridType const & G,std::vector<T> const & X){
+    size_t errors = count_batch_errors(G,X);
+    for(T x : X){
+        size_t i = G.pos(x);
+        if(G.contains(x)){
+            errors += !(G[i] <= x && x <= G[i+1]);
+        }
+    }
+    return errors;
+}
+
+/// @brief put_batch and loop of put give the same histogram
+template <typename GridType,typename T>
+size_t count_fill_errors(GridType const & G,std::vector<T> const & X){
+    auto H = grob::make_histo<double>(G);
+    size_t inside_scalar = 0;
+    for(T x : X){
+        inside_scalar += H.put(1.0,x);
+    }
+    auto HB = grob::make_histo<double>(G);
+    size_t inside_batch = HB.put_batch(1.0,X.data(),X.size());
+    return (inside_scalar != inside_batch) + (H.Values != HB.Values);
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-9,9);
+    const size_t N = 1 << 20;
+    std::vector<double> X(N);
+    std::vector<float> Xf(N);
+    for(size_t i=0;i<N;++i){
+        Xf[i] = X[i] = std::pow(10.0,dist(gen));
+    }
+    X[1] = Xf[1] = -1.0;
+    X[2] = Xf[2] = 0.0;
+    X[3] = Xf[3] = -0.0;
+    X[4] = Xf[4] = NAN;
+    X[5] = Xf[5] = INFINITY;
+
+    grob::GridLogLinear<double> G(1e-6,1e6,5);
+    grob::GridLogLinear<float> Gf(1e-6f,1e6f,5);
+    PVAR(G);
+    TEST(G.front() <= 1e-6 && G.back() >= 1e6,true);
+    TEST(count_errors(G,X),0);
+    TEST(count_errors(Gf,Xf),0);
+    TEST(G.pos(-1.0),0);
+
+    double max_rel_width = 0;
+    for(size_t i=0;i+1<G.size();++i){
+        max_rel_width = std::max(max_rel_width,(G[i+1]-G[i])/G[i]);
+    }
+    TEST(max_rel_width <= 1.0/32,true);
+
+    grob::GridLogLinearHisto<double> GH(1e-6,1e6,5);
+    TEST(count_batch_errors(GH,X),0);
+
+    TEST(count_fill_errors(GH,X),0);
+
+    // samples exactly on bin edges: integer data on integer edges
+    std::vector<double> integer_edges(33),square_edges(20);
+    for(size_t i=0;i<integer_edges.size();++i){
+        integer_edges[i] = i;
+    }
+    for(size_t i=0;i<square_edges.size();++i){
+        square_edges[i] = 0.1*i*i;
+    }
+    std::uniform_int_distribution<int> idist(-2,34);
+    std::vector<double> XI(10001);
+    for(auto & x : XI){
+        x = idist(gen);
+    }
+    std::vector<double> XS;
+    for(size_t r=0;r<37;++r){
+        XS.insert(XS.end(),square_edges.begin(),square_edges.end());
+    }
+    TEST(count_fill_errors(grob::GridVectorHisto<double>(integer_edges),XI),0);
+    TEST(count_fill_errors(grob::GridVectorHisto<double>(square_edges),XS),0);
+    TEST(count_fill_errors(grob::GridUniformHisto<double>(0,32,33),XI),0);
+    TEST(count_fill_errors(grob::GridLogLinearHisto<double>(1,32,2),XI),0);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/mmap_io.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdio>
+#include <cstddef>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(5 + i % 17);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = (1 + 0.001*i)*t*t;
+    }
+    return nodes;
+}
+
+template <typename MappedType>
+bool inside_mapping(MappedType const & M,const void * ptr){
+    const char * p = static_cast<const char *>(ptr);
+    return p >= M.File->data() && p < M.File->data() + M.File->size();
+}
+
+int main(){
+    // each object is written to its own file, mapped files are not overwritten
+    const std::string path = "/tmp/grob_test_mmap_io";
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 100000;
+
+    // 1-dim functions
+    auto F1 = grob::make_function_f(grob::GridVector<double>(inner_nodes(20)),[](double x){return x*x;});
+    grob::mmap_io::save(path + "_1",F1);
+    auto M1 = grob::mmap_io::load<decltype(F1)>(path + "_1");
+    TEST(M1->size(),F1.size());
+    TEST(inside_mapping(M1,M1->Values.data()),true);
+    TEST(inside_mapping(M1,M1->Grid.container().data()),true);
+    size_t errors = 0;
+    for(size_t k=0;k<N;++k){
+        double x = dist(gen);
+        errors += (M1(x) != F1(x));
+    }
+    TEST(errors,0);
+
+    auto FU = grob::make_function_f(grob::GridUniform<double>(0,1,101),[](double x){return std::sin(x);});
+    grob::mmap_io::save(path + "_u",FU);
+    auto MU = grob::mmap_io::load<decltype(FU)>(path + "_u");
+    for(size_t k=0;k<N;++k){
+        double x = dist(gen);
+        errors += (MU(x) != FU(x));
+    }
+    TEST(errors,0);
+
+    // layout mismatch is reported
+    bool thrown = false;
+    try{
+        grob::mmap_io::load<decltype(F1)>(path + "_u");
+    }catch(std::runtime_error const & e){
+        thrown = true;
+        PVAR(e.what());
+    }
+    TEST(thrown,true);
+
+    // corrupted count of first block: count*sizeof(double) wraps around to 8 bytes
+    {
+        std::ifstream in(path + "_1",std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(in)),std::istreambuf_iterator<char>());
+        uint64_t count = (uint64_t(1) << 61) + 1;
+        std::memcpy(bytes.data() + sizeof(grob::mmap_io::file_header) + offsetof(grob::mmap_io::block_header,count),
+            &count,sizeof(count));
+        std::ofstream out(path + "_c",std::ios::binary);
+        out.write(bytes.data(),bytes.size());
+    }
+    thrown = false;
+    try{
+        grob::mmap_io::load<decltype(F1)>(path + "_c");
+    }catch(std::runtime_error const & e){
+        thrown = true;
+        PVAR(e.what());
+    }
+    TEST(thrown,true);
+
+    // failed write is reported
+    thrown = false;
+    try{
+        std::ostream bad(nullptr);
+        grob::mmap_io::save(bad,F1);
+    }catch(std::runtime_error const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+
+    // 2-dim function over ragged grid
+    const size_t M = 20000;
+    auto f = [](auto const & P){auto [x,y] = P;return x*x + y;};
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto F2 = grob::make_function_f<I2>(
+        grob::make_grid_f(grob::GridUniform<double>(0,1,M),[](size_t i){return grob::GridVector<double>(inner_nodes(i));}),f);
+    grob::mmap_io::save(path + "_2",F2);
+    auto M2 = grob::mmap_io::load<decltype(F2)>(path + "_2");
+    TEST(M2->size(),F2.size());
+    TEST(inside_mapping(M2,M2->Grid.inner().Nodes.data()),true);
+    for(size_t k=0;k<N;++k){
+        double x = dist(gen),y = dist(gen);
+        errors += (M2(x,y) != F2(x,y));
+        errors += (M2->Grid.locate_linear(x,y) != F2.Grid.locate_linear(x,y));
+    }
+    for(auto [MI,i,X,V] : M2->enumerate()){
+        errors += (V != F2.Values[i]) + !(X == F2.Grid[MI]);
+    }
+    TEST(errors,0);
+
+    // packed grid is saved the same way
+    auto FP = grob::make_function_f<I2>(grob::make_grid_packed(grob::GridUniform<double>(0,1,M),inner_nodes),f);
+    grob::mmap_io::save(path + "_p",FP);
+    auto MP = grob::mmap_io::load<decltype(FP)>(path + "_p");
+    TEST(std::equal(MP->Values.begin(),MP->Values.end(),F2.Values.begin()),true);
+
+    // 2-dim histogram
+    auto H = grob::make_histo<double>(grob::make_grid_f(grob::GridUniformHisto<double>(0,1,M),
+                [](size_t i){return grob::GridVectorHisto<double>(inner_nodes(i));}));
+    for(size_t k=0;k<N;++k){
+        H.put(1.0,dist(gen),dist(gen));
+    }
+    grob::mmap_io::save(path + "_h",H);
+    auto MH = grob::mmap_io::load<decltype(H)>(path + "_h");
+    TEST(MH->size(),H.size());
+    for(size_t k=0;k<N;++k){
+        double x = dist(gen),y = dist(gen);
+        errors += (MH->Grid.locate_linear(x,y) != H.Grid.locate_linear(x,y));
+    }
+    for(auto [MI,i,X,V] : MH->enumerate()){
+        errors += (V != H.Values[i]) + (H.Grid.LinearIndex(MI) != i);
+    }
+    TEST(errors,0);
+
+    for(auto suf : {"_1","_u","_c","_2","_p","_h"}){
+        std::remove((path + suf).c_str());
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/cubic_spline.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> nodes(size_t M){
+    std::vector<double> X(M);
+    for(size_t i=0;i<M;++i){
+        X[i] = std::pow(i/(M - 1.0),1.5);
+    }
+    return X;
+}
+
+/// @return true if F is within [min,max] of node values in each cell and has no extra extrema
+template <typename FuncType>
+bool no_overshoot(FuncType const & F,size_t steps = 50){
+    for(size_t i=0;i+1<F.Grid.size();++i){
+        double v0 = F(F.Grid[i]),v1 = F(F.Grid[i+1]);
+        double prev = v0;
+        for(size_t k=1;k<=steps;++k){
+            double v = F(F.Grid[i] + (F.Grid[i+1] - F.Grid[i])*k/steps);
+            if(v < std::min(v0,v1) - 1e-12 || v > std::max(v0,v1) + 1e-12)
+                return false;
+            if((v1 - v0)*(v - prev) < -1e-12)
+                return false;
+            prev = v;
+        }
+    }
+    return true;
+}
+
+template <typename F1,typename F2>
+double max_diff(F1 const & F,F2 const & G,std::vector<double> const & xs){
+    double diff = 0;
+    for(double x : xs){
+        diff = std::max(diff,std::abs(F(x) - G(x)));
+    }
+    return diff;
+}
+
+int main(){
+    using grob::spline_kind;
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    std::vector<double> X(10000);
+    for(auto & x : X){
+        x = dist(gen);
+    }
+    const double eps = 1e-12;
+    // step-like data with plateaus and a jump
+    auto step = [](double x){return (x < 0.3 ? 0.0 : (x < 0.35 ? 1.0 : 1.0 + 0.1*x));};
+    auto line = [](double x){return 1 - 2*x;};
+
+    for(spline_kind kind : {spline_kind::pchip,spline_kind::steffen,spline_kind::akima}){
+        for(size_t M : {2,3,4,20}){
+            // linear functions are exact
+            TEST(max_diff(grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),line,kind),line,X) < eps,true);
+            TEST(max_diff(grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),line,kind),line,X) < eps,true);
+            // nodes are interpolated
+            auto F = grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),[](double x){return std::sin(5*x);},kind);
+            double diff = 0;
+            for(size_t i=0;i<M;++i){
+                diff = std::max(diff,std::abs(F(F.Grid[i]) - std::sin(5*F.Grid[i])));
+            }
+            TEST(diff < eps,true);
+        }
+    }
+
+    // monotone kinds keep monotonicity of data, hermite spline overshoots
+    for(size_t M : {5,20,41}){
+        TEST(no_overshoot(grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),step,spline_kind::pchip)),true);
+        TEST(no_overshoot(grob::make_spline_function_f(grob::GridVector<double>(nodes(M)),step,spline_kind::steffen)),true);
+        TEST(no_overshoot(grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),step,spline_kind::pchip)),true);
+        TEST(no_overshoot(grob::make_spline_function_f(grob::GridUniform<double>(0,1,M),step,spline_kind::steffen)),true);
+    }
+    TEST(no_overshoot(grob::make_spline_function_f(grob::GridUniform<double>(0,1,41),step)),false);
+
+    // akima: flat data stays flat near a jump
+    auto AK = grob::make_spline_function_f(grob::GridUniform<double>(0,1,21),
+        [](double x){return (x < 0.5 ? 0.0 : 1.0);},spline_kind::akima);
+    TEST(max_diff(AK,[](double){return 0.0;},{0.02,0.13,0.27,0.36}) < eps,true);
+    TEST(max_diff(AK,[](double){return 1.0;},{0.63,0.74,0.88,0.97}) < eps,true);
+
+    // smooth data: all kinds converge, monotone ones flatten extrema
+    auto f = [](double x){return std::sin(5*x) + x*x;};
+    TEST(max_diff(grob::make_spline_function_f(grob::GridVector<double>(nodes(200)),f,spline_kind::pchip),f,X) < 1e-3,true);
+    TEST(max_diff(grob::make_spline_function_f(grob::GridVector<double>(nodes(200)),f,spline_kind::steffen),f,X) < 1e-3,true);
+    TEST(max_diff(grob::make_spline_function_f(grob::GridVector<double>(nodes(200)),f,spline_kind::akima),f,X) < 1e-5,true);
+
+    // functional grid: interpolHidden builds polynomials in hidden (log) coordinate
+    auto g = [](double x){return std::atan(std::log(x));};
+    grob::GridLog<double> GL(1e-3,1e3,31);
+    auto FH = grob::make_spline_function_f<grob::interpolHidden<grob::interpolator_cubic_spline>>(GL,g,spline_kind::pchip);
+    std::vector<double> VL(GL.size());
+    for(size_t i=0;i<GL.size();++i){
+        VL[i] = g(GL[i]);
+    }
+    auto FU = grob::make_spline_function(grob::GridUniform<double>(GL.to_hidden(GL.front()),GL.to_hidden(GL.back()),GL.size()),
+        VL,spline_kind::pchip);
+    auto FX = grob::make_spline_function_f(GL,g,spline_kind::pchip);
+    double diff_h = 0,diff_x = 0;
+    for(double t : X){
+        double x = std::exp(std::log(1e-3) + t*std::log(1e6));
+        diff_h = std::max(diff_h,std::abs(FH(x) - FU(GL.to_hidden(x))));
+        diff_x = std::max(diff_x,std::abs(FX(x) - g(x)));
+    }
+    TEST(diff_h < 1e-9,true);
+    TEST(diff_x < 0.01,true);
+    TEST(std::abs(FX(GL[10]) - g(GL[10])) < eps,true);
+    grob::GridSqrt<double> GS(0,4,9);
+    auto FS = grob::make_spline_function_f<grob::interpolHidden<grob::interpolator_cubic_spline>>(GS,
+        [](double x){return std::sqrt(x);},spline_kind::steffen);
+    TEST(max_diff(FS,[](double x){return std::sqrt(x);},{0.01,0.3,1.7,3.9}) < eps,true);
+    return 0;
+}
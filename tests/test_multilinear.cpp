@@ -0,0 +1,95 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+typedef grob::interProd<grob::linear_interpolator,I2> I3;
+
+/// @return max difference between multilinear_interpolator and interProd on points X
+template <typename Interpolator,typename FuncType,typename PointsType>
+double max_diff(FuncType const & F,PointsType const & X){
+    double diff = 0;
+    for(auto const & P : X){
+        double r = grob::multilinear_interpolator::interpolate(F.Grid,F.Values,P);
+        double r0 = Interpolator::interpolate(F.Grid,F.Values,P);
+        diff = std::max(diff,std::abs(r - r0));
+    }
+    return diff;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 10000;
+    std::vector<grob::Point<double,double>> X2(N);
+    for(auto & P : X2){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(3*y);};
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    const double eps = 1e-12;
+
+    // 2-dim ragged and packed grids
+    grob::GridUniform<double> G0(0,1,101);
+    auto F2 = grob::make_function_f<I2>(grob::make_grid_f(G0,[](size_t i){return grob::GridVector<double>(inner_nodes(i));}),f2);
+    TEST(max_diff<I2>(F2,X2) < eps,true);
+    auto F2p = grob::make_function_f<I2>(grob::make_grid_packed(G0,inner_nodes),f2);
+    TEST(max_diff<I2>(F2p,X2) < eps,true);
+    auto F2u = grob::make_function_f<I2>(grob::make_grid_uniform_rows(G0,
+        [](size_t i){return grob::GridUniform<double>(-0.001*i,1 + 0.002*i,5 + i % 9);}),f2);
+    TEST(max_diff<I2>(F2u,X2) < eps,true);
+
+    // default interpolator of make_function_f is multilinear for MultiGrid
+    auto F2d = grob::make_function_f(F2.Grid,f2);
+    double diff = 0;
+    for(size_t k=0;k<1000;++k){
+        auto [x,y] = X2[k];
+        diff = std::max(diff,std::abs(F2d(x,y) - F2(x,y)));
+    }
+    TEST(diff < eps,true);
+
+    // 3-dim regular, ragged and rectilinear grids
+    auto F3m = grob::make_function_f<I3>(grob::mesh_grids(grob::GridUniform<double>(0,1,41),
+        grob::mesh_grids(grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,31))),f3);
+    TEST(max_diff<I3>(F3m,X3) < eps,true);
+    auto F3r = grob::make_function_f<I3>(grob::make_grid_f(grob::GridUniform<double>(0,1,41),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        }),f3);
+    TEST(max_diff<I3>(F3r,X3) < eps,true);
+    auto F3R = grob::make_function_f<I3>(grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,41),
+        grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,31)),f3);
+    TEST(max_diff<I3>(F3R,X3) < eps,true);
+
+    // multilinear function is reproduced exactly, also outside of grid
+    auto lin3 = [](auto const & P){auto [x,y,z] = P;return 1 + x - 2*y + 3*z + x*y*z;};
+    auto FL = grob::make_function_f<grob::linear_extrapolator>(grob::make_grid_f(grob::GridUniform<double>(0,1,11),
+        [](size_t i){return grob::mesh_grids(grob::GridVector<double>(inner_nodes(i)),grob::GridUniform<double>(0,1,5 + i));}),lin3);
+    std::uniform_real_distribution<double> dist_out(-1,2);
+    diff = 0;
+    for(size_t k=0;k<10000;++k){
+        double x = dist_out(gen),y = dist_out(gen),z = dist_out(gen);
+        diff = std::max(diff,std::abs(FL(x,y,z) - lin3(grob::make_point(x,y,z))));
+    }
+    TEST(diff < 1e-10,true);
+    return 0;
+}
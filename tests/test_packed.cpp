@@ -0,0 +1,71 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(5 + i % 17);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = (1 + 0.001*i)*t*t;
+    }
+    return nodes;
+}
+
+int main(){
+    const size_t M = 20000;
+    grob::GridUniform<double> G0(0,1,M);
+    auto GV = grob::make_grid_f(G0,[](size_t i){return grob::GridVector<double>(inner_nodes(i));});
+    auto GP = grob::make_grid_packed(G0,inner_nodes);
+    TEST(GP.size(),GV.size());
+    TEST(GP.inner().Nodes.size(),GV.size());
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 16;
+    std::vector<std::pair<double,double>> X(N);
+    for(auto & xy : X){
+        xy = {dist(gen),dist(gen)};
+    }
+    size_t errors = 0;
+    for(auto [x,y] : X){
+        errors += (GP.LinearIndex(GP.pos(x,y)) != GV.LinearIndex(GV.pos(x,y)));
+        errors += (GP.locate_linear(x,y) != GV.locate_linear(x,y));
+    }
+    TEST(errors,0);
+    for(auto [MI,i,P] : GP.enumerate()){
+        errors += (P != GV[MI]);
+    }
+    TEST(errors,0);
+    TEST(GP.inner(size_t(7)).size(),GV.inner(size_t(7)).size());
+
+    // grid function and histogram
+    auto f = [](auto const & P){auto [x,y] = P;return x*x + y;};
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto FP = grob::make_function_f<I2>(GP,f);
+    auto FV = grob::make_function_f<I2>(GV,f);
+    TEST(FP.Values == FV.Values,true);
+    double max_diff = 0;
+    for(size_t k=0;k<1000;++k){
+        auto [x,y] = X[k];
+        max_diff = std::max(max_diff,std::abs(FP(x,y) - FV(x,y)));
+    }
+    TEST(max_diff,0);
+
+    auto HP = grob::make_histo<double>(grob::make_histo_grid_packed(grob::GridUniformHisto<double>(0,1,M),inner_nodes));
+    auto HV = grob::make_histo<double>(grob::make_grid_f(grob::GridUniformHisto<double>(0,1,M),
+                [](size_t i){return grob::GridVectorHisto<double>(inner_nodes(i));}));
+    TEST(HP.size(),HV.size());
+    size_t inside_p = 0,inside_v = 0;
+    for(auto [x,y] : X){
+        inside_p += HP.put(1.0,x,y);
+        inside_v += HV.put(1.0,x,y);
+    }
+    TEST(inside_p,inside_v);
+    TEST(HP.Values == HV.Values,true);
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <cmath>
+
+template <typename GridType>
+size_t check_partition(GridType const & G,size_t k){
+    auto ranges = G.partition(k);
+    size_t errors = (ranges.size() != k);
+    size_t next = 0;
+    size_t max_size = 0,min_size = G.size();
+    for(auto const & r : ranges){
+        errors += (r.begin != next);
+        next = r.end;
+        max_size = std::max(max_size,r.size());
+        min_size = std::min(min_size,r.size());
+        for(auto [MI,i,X] : grob::GridEnumerator<GridType>(G,r)){
+            errors += (G.LinearIndex(MI) != i) + (i < r.begin || i >= r.end);
+        }
+    }
+    errors += (next != G.size()) + (max_size - min_size > 1);
+    return errors;
+}
+
+int main(){
+    grob::GridVector<double> G1(std::vector<double>{0,0.1,0.5,1});
+    auto G2 = grob::make_grid_f(grob::GridUniform<double>(0,1,11),[](size_t i){
+        return grob::GridUniform<double>(-0.1*i,1 + 0.1*i,5 + 3*i);
+    });
+    auto G3 = grob::mesh_grids(grob::GridUniform<double>(-1,1,9),G2);
+    auto R3 = grob::make_rectilinear_grid(grob::GridUniform<double>(-1,1,9),G1,
+                grob::GridUniform<double>(0,2,7));
+    for(size_t k : {1,2,3,7,16}){
+        TEST(check_partition(G1,k),0);
+        TEST(check_partition(G2,k),0);
+        TEST(check_partition(G3,k),0);
+        TEST(check_partition(R3,k),0);
+    }
+    // more ranges than points
+    TEST(check_partition(G1,10),0);
+
+    // parallel make_function_f and map
+    auto f = [](auto const & P){
+        auto [x,y,z] = P;
+        double s = 0;
+        for(size_t k=1;k<200;++k){
+            s += std::sin(k*x)*std::cos(k*y)/k + z/(k*k);
+        }
+        return s;
+    };
+    typedef grob::interProd<grob::linear_interpolator,
+                grob::interProd<grob::linear_interpolator,grob::linear_interpolator>> I3;
+    auto F1 = grob::make_function_f<I3>(G3,f);
+    auto F4 = grob::make_function_f<I3>(G3,f,4);
+    TEST(F1.Values == F4.Values,true);
+
+    F1.map([](auto const & P){auto [x,y,z] = P;return x*y + z;});
+    F4.map([](auto const & P){auto [x,y,z] = P;return x*y + z;},3);
+    TEST(F1.Values == F4.Values,true);
+
+    auto FR = grob::make_function_f<I3>(R3,f,5);
+    auto FR1 = grob::make_function_f<I3>(R3,f);
+    TEST(FR.Values == FR1.Values,true);
+
+    // exceptions from workers (in new threads and in calling thread) are rethrown after join
+    for(double bad_x : {0.75,-1.0}){
+        bool thrown = false;
+        try{
+            F4.map([bad_x](auto const & P){
+                if(std::get<0>(P) == bad_x)
+                    throw std::runtime_error("bad point");
+                return 0.0;
+            },4);
+        }catch(std::runtime_error const &){
+            thrown = true;
+        }
+        TEST(thrown,true);
+    }
+    bool thrown = false;
+    try{
+        grob::make_function_f<I3>(R3,[](auto const &) -> double {throw std::domain_error("everywhere");},8);
+    }catch(std::domain_error const &){
+        thrown = true;
+    }
+    TEST(thrown,true);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+/// @brief pos_batch must coincide with pos for every query, build also with -mavx2 and -mavx512f
+/// to check vector kernels. Batches start at several offsets, so each query goes
+/// through vector lanes and through scalar tail
+template <typename GridType,typename T>
+size_t count_mismatches(GridType const & G,std::vector<T> const & X){
+    std::vector<size_t> out(X.size());
+    size_t errors = 0;
+    for(size_t s=0;s<17 && s<=X.size();++s){
+        G.pos_batch(X.data() + s,X.size() - s,out.data());
+        for(size_t i=s;i<X.size();++i){
+            errors += (out[i-s] != G.pos(X[i]));
+        }
+    }
+    return errors;
+}
+
+/// @brief nodes of grid, midpoints of cells and points outside
+template <typename T>
+std::vector<T> node_queries(std::vector<T> const & nodes){
+    std::vector<T> X(nodes.begin(),nodes.end());
+    for(size_t i=0;i+1<nodes.size();++i){
+        X.push_back((nodes[i] + nodes[i+1])/2);
+    }
+    X.push_back(nodes.front() - 1);
+    X.push_back(nodes.back() + 1);
+    X.push_back(NAN);
+    return X;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+
+    std::vector<double> Xd(1 << 14);
+    std::vector<float> Xf(Xd.size());
+    for(size_t i=0;i<Xd.size();++i){
+        Xf[i] = Xd[i] = dist(gen);
+    }
+    Xd[3] = Xd[17] = NAN;
+    Xf[3] = Xf[17] = NAN;
+
+    grob::GridUniform<double> Ud(0,1,1001);
+    grob::GridUniform<float> Uf(0,1,1001);
+    grob::GridUniformHisto<double> HUd(0,1,1001);
+    TEST(count_mismatches(Ud,Xd),0);
+    TEST(count_mismatches(Uf,Xf),0);
+    TEST(count_mismatches(HUd,Xd),0);
+    TEST(count_mismatches(Ud,Xf),0);
+
+    std::vector<double> cubic(10001);
+    for(size_t i=0;i<cubic.size();++i){
+        double t = i/(cubic.size()-1.0);
+        cubic[i] = t*t*t;
+    }
+    grob::GridVector<double> Vd(cubic);
+    grob::GridVector<float> Vf(std::vector<float>(cubic.begin(),cubic.end()));
+    grob::GridVectorHisto<double> HVd(cubic);
+    grob::GridVector<double> V2(std::vector<double>{0.5,0.7});
+    TEST(count_mismatches(Vd,Xd),0);
+    TEST(count_mismatches(Vf,Xf),0);
+    TEST(count_mismatches(HVd,Xd),0);
+    TEST(count_mismatches(V2,Xd),0);
+
+    // queries equal to nodes
+    std::vector<double> square(20),integer(64);
+    for(size_t i=0;i<square.size();++i){
+        square[i] = 0.1*i*i;
+    }
+    for(size_t i=0;i<integer.size();++i){
+        integer[i] = i;
+    }
+    for(auto const * nodes : {&square,&integer,&cubic}){
+        std::vector<double> X = node_queries(*nodes);
+        std::vector<float> nodes_f(nodes->begin(),nodes->end());
+        std::vector<float> X_f = node_queries(nodes_f);
+        TEST(count_mismatches(grob::GridVector<double>(*nodes),X),0);
+        TEST(count_mismatches(grob::GridVectorHisto<double>(*nodes),X),0);
+        TEST(count_mismatches(grob::GridVector<float>(nodes_f),X_f),0);
+    }
+    TEST(count_mismatches(V2,node_queries(std::vector<double>{0.5,0.7})),0);
+    return 0;
+}
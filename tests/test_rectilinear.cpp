@@ -0,0 +1,97 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+int main(){
+    grob::GridUniform<double> GX(0,1,11);
+    grob::GridVector<double> GY(std::vector<double>{-1,-0.5,0,0.1,0.7,1});
+    grob::GridUniform<double> GZ(0,2,7);
+
+    auto R3 = grob::make_rectilinear_grid(GX,GY,GZ);
+    auto M3 = grob::mesh_grids(GX,grob::mesh_grids(GY,GZ));
+    PVAR(R3);
+    TEST(R3.size(),M3.size());
+    TEST(R3.Dim,3);
+
+    // the same traversal order and points
+    size_t errors = 0;
+    size_t i = 0;
+    auto MI = M3.MultiZero();
+    for(auto RI = R3.MultiZero();!R3.IsEnd(RI);R3.MultiIncrement(RI),M3.MultiIncrement(MI),++i){
+        errors += (R3.LinearIndex(RI) != i) + (M3.LinearIndex(MI) != i);
+        errors += (R3[RI] != M3[MI]);
+        errors += (R3.FromLinear(i) != RI);
+    }
+    TEST(errors,0);
+    TEST(i,R3.size());
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.2,2.2);
+    const size_t N = 1 << 16;
+    std::vector<grob::Point<double,double,double>> X(N);
+    for(auto & P : X){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    for(auto const & P : X){
+        auto [x,y,z] = P;
+        auto mi_m = M3.pos(x,y,z);
+        auto mi_r = R3.pos(x,y,z);
+        errors += (R3.LinearIndex(mi_r) != M3.LinearIndex(mi_m));
+        errors += (R3.contains(x,y,z) != M3.contains(x,y,z));
+        auto li = R3.locate_linear_tuple(P.as_tuple());
+        auto li_m = M3.locate_linear_tuple(P.as_tuple());
+        errors += (li != li_m);
+        errors += (std::get<0>(R3.spos(x,y,z)) != li.has_value());
+    }
+    TEST(errors,0);
+
+    // grid function
+    auto f3 = [](auto const & P){
+        auto [x,y,z] = P;
+        return x + 2*y - z + x*y;
+    };
+    typedef grob::interProd<grob::linear_interpolator,
+                grob::interProd<grob::linear_interpolator,grob::linear_interpolator>> I3;
+    auto FR = grob::make_function_f<I3>(R3,f3);
+    auto FM = grob::make_function_f<I3>(M3,f3);
+    TEST(FR.Values == FM.Values,true);
+    double max_diff = 0;
+    for(size_t k=0;k<1000;++k){
+        auto [x,y,z] = X[k];
+        max_diff = std::max(max_diff,std::abs(FR(x,y,z) - FM(x,y,z)));
+    }
+    TEST(max_diff < 1e-12,true);
+    COMPARE(FR(0.33,0.2,1.1),f3(grob::make_point(0.33,0.2,1.1)));
+
+    // histogramm
+    auto HR = grob::make_histo<double>(grob::make_rectilinear_grid(
+        grob::GridUniformHisto<double>(0,1,11),grob::GridUniformHisto<double>(0,1,6),
+        grob::GridVectorHisto<double>(std::vector<double>{0,0.1,0.5,1})));
+    auto HM = grob::make_histo<double>(grob::mesh_grids(grob::GridUniformHisto<double>(0,1,11),
+        grob::mesh_grids(grob::GridUniformHisto<double>(0,1,6),
+        grob::GridVectorHisto<double>(std::vector<double>{0,0.1,0.5,1}))));
+    TEST(HR.size(),HM.size());
+    size_t inside_r = 0,inside_m = 0;
+    for(auto const & P : X){
+        inside_r += HR.put_point(1.0,P);
+        inside_m += HM.put_point(1.0,P);
+    }
+    TEST(inside_r,inside_m);
+    TEST(HR.Values == HM.Values,true);
+
+    // default constructed grid is empty
+    decltype(R3) R0;
+    TEST(R0.size(),0);
+    TEST(R0.IsEnd(R0.MultiZero()),true);
+    size_t visited = 0;
+    for(auto RI = R0.MultiZero();!R0.IsEnd(RI);R0.MultiIncrement(RI)){
+        ++visited;
+    }
+    TEST(visited,0);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+/// @brief the same interpolation without stencil, interpolator_product falls back to full inner interpolation
+template <typename Interpolator>
+struct no_stencil{
+    template <typename GridType,typename ContainerType,typename Point_t>
+    inline static auto interpolate(GridType const & grid,ContainerType const & values,Point_t const & point){
+        return Interpolator::interpolate(grid,values,point);
+    }
+};
+typedef no_stencil<grob::linear_interpolator> L0;
+typedef no_stencil<grob::spline1D> S0;
+using grob::linear_interpolator;
+using grob::spline1D;
+
+std::vector<double> inner_nodes(size_t i){
+    std::vector<double> nodes(4 + i % 7);
+    for(size_t j=0;j<nodes.size();++j){
+        double t = j/(nodes.size() - 1.0);
+        nodes[j] = -0.05*(i%3) + (1 + 0.01*i)*t*t;
+    }
+    return nodes;
+}
+
+/// @return max difference of interpolators I and I0 over points X
+template <typename I,typename I0,typename GridType,typename FuncType,typename PointsType>
+double max_diff(GridType const & G,FuncType const & f,PointsType const & X){
+    auto F = grob::make_function_f<I>(G,f);
+    double diff = 0;
+    for(auto const & P : X){
+        diff = std::max(diff,std::abs(I::interpolate(F.Grid,F.Values,P) - I0::interpolate(F.Grid,F.Values,P)));
+    }
+    return diff;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 10000;
+    std::vector<grob::Point<double,double>> Y(N);
+    for(auto & P : Y){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    std::vector<grob::Point<double,double,double>> X(N);
+    for(auto & P : X){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(3*y);};
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y*z + std::sin(3*y) - z*z;};
+    const double eps = 1e-12;
+
+    // 1-dim stencils reproduce interpolate, including small grids
+    for(size_t M : {2,3,4,5,30}){
+        grob::GridUniform<double> GU(0,1,M);
+        grob::GridVector<double> GV(inner_nodes(M + 1));
+        std::vector<double> V(M + 5);
+        for(size_t i=0;i<V.size();++i){
+            V[i] = std::sin(3.0*i);
+        }
+        double diff = 0;
+        for(size_t k=0;k<1000;++k){
+            double x = dist(gen);
+            std::array<size_t,4> o;
+            std::array<double,4> w;
+            spline1D::stencil(GU,x,o,w);
+            double s = 0;
+            for(size_t c=0;c<4;++c){
+                s += w[c]*V[o[c]];
+                diff += (o[c] >= GU.size());
+            }
+            diff = std::max(diff,std::abs(s - spline1D::interpolate(GU,V,x)));
+            spline1D::stencil(GV,x,o,w);
+            s = 0;
+            for(size_t c=0;c<4;++c){
+                s += w[c]*V[o[c]];
+                diff += (o[c] >= GV.size());
+            }
+            diff = std::max(diff,std::abs(s - spline1D::interpolate(GV,V,x)));
+        }
+        TEST(diff < eps,true);
+    }
+
+    // 2-dim: regular and ragged grids
+    auto G2m = grob::mesh_grids(grob::GridUniform<double>(0,1,21),grob::GridVector<double>(inner_nodes(5)));
+    auto G2r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),[](size_t i){return grob::GridVector<double>(inner_nodes(i));});
+    TEST((max_diff<grob::interProd<spline1D,spline1D>,grob::interProd<S0,S0>>(G2m,f2,Y) < eps),true);
+    TEST((max_diff<grob::interProd<spline1D,spline1D>,grob::interProd<S0,S0>>(G2r,f2,Y) < eps),true);
+    TEST((max_diff<grob::interProd<linear_interpolator,spline1D>,grob::interProd<L0,S0>>(G2r,f2,Y) < eps),true);
+    TEST((max_diff<grob::interProd<spline1D,S0>,grob::interProd<S0,S0>>(G2r,f2,Y) < eps),true);
+    TEST((max_diff<grob::interProd<linear_interpolator,linear_interpolator>,grob::linear_interpolator>(G2r,f2,Y) < eps),true);
+
+    // 3-dim: mesh, ragged and rectilinear
+    auto G3m = grob::mesh_grids(grob::GridUniform<double>(0,1,21),
+        grob::mesh_grids(grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,17)));
+    auto G3r = grob::make_grid_f(grob::GridUniform<double>(0,1,21),
+        [](size_t i){
+            return grob::make_grid_f(grob::GridVector<double>(inner_nodes(i)),
+                [i](size_t j){return grob::GridVector<double>(inner_nodes(i + j));});
+        });
+    auto G3R = grob::make_rectilinear_grid(grob::GridUniform<double>(0,1,21),
+        grob::GridVector<double>(inner_nodes(5)),grob::GridUniform<double>(0,1,17));
+    typedef grob::interProd3<spline1D,spline1D,spline1D> S3;
+    typedef grob::interProd3<S0,S0,S0> S3_0;
+    typedef grob::interProd3<spline1D,linear_interpolator,spline1D> SLS;
+    typedef grob::interProd3<S0,L0,S0> SLS_0;
+    TEST((max_diff<S3,S3_0>(G3m,f3,X) < eps),true);
+    TEST((max_diff<S3,S3_0>(G3r,f3,X) < eps),true);
+    TEST((max_diff<S3,S3_0>(G3R,f3,X) < eps),true);
+    TEST((max_diff<SLS,SLS_0>(G3r,f3,X) < eps),true);
+
+    // batch evaluation through stencils
+    auto F3 = grob::make_function_f<S3>(G3r,f3);
+    std::vector<double> out(X.size());
+    F3.eval_batch(X.data(),X.size(),out.data());
+    double diff = 0;
+    for(size_t k=0;k<X.size();++k){
+        diff = std::max(diff,std::abs(out[k] - F3.eval(X[k])));
+    }
+    TEST(diff < eps,true);
+    return 0;
+}
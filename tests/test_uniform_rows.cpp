@@ -0,0 +1,78 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+grob::GridUniform<double> equal_row(size_t i){
+    return grob::GridUniform<double>(-0.001*i,1 + 0.002*i,33);
+}
+grob::GridUniform<double> ragged_row(size_t i){
+    return grob::GridUniform<double>(-0.001*i,1 + 0.002*i,5 + i % 29);
+}
+
+template <typename RowFunc>
+size_t check_rows(size_t M,RowFunc row,std::vector<std::pair<double,double>> const & X){
+    grob::GridUniform<double> G0(0,1,M);
+    auto GV = grob::make_grid_f(G0,row);
+    auto GU = grob::make_grid_uniform_rows(G0,row);
+    size_t errors = (GU.size() != GV.size());
+    for(auto [x,y] : X){
+        errors += (GU.LinearIndex(GU.pos(x,y)) != GV.LinearIndex(GV.pos(x,y)));
+        errors += (GU.locate_linear(x,y) != GV.locate_linear(x,y));
+    }
+    for(auto [MI,i,P] : GU.enumerate()){
+        errors += (P != GV[MI]) + (GV.LinearIndex(MI) != i);
+    }
+    std::vector<double> xs(X.size()),ys(X.size());
+    for(size_t k=0;k<X.size();++k){
+        std::tie(xs[k],ys[k]) = X[k];
+    }
+    std::vector<size_t> ui(X.size()),uj(X.size()),vi(X.size()),vj(X.size());
+    GU.pos_batch(xs.data(),ys.data(),X.size(),ui.data(),uj.data());
+    GV.pos_batch(xs.data(),ys.data(),X.size(),vi.data(),vj.data());
+    for(size_t k=0;k<X.size();++k){
+        auto mi = GV.pos(xs[k],ys[k]);
+        errors += (ui[k] != mi.i) + (uj[k] != mi.m) + (vi[k] != mi.i) + (vj[k] != mi.m);
+    }
+    return errors;
+}
+
+int main(){
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-0.1,1.1);
+    const size_t N = 1 << 16;
+    std::vector<std::pair<double,double>> X(N);
+    for(auto & xy : X){
+        xy = {dist(gen),dist(gen)};
+    }
+    X[1].second = NAN;
+
+    const size_t M = 2000;
+    TEST(check_rows(M,equal_row,X),0);
+    TEST(check_rows(M,ragged_row,X),0);
+
+    grob::GridUniform<double> G0(0,1,M);
+    auto GU = grob::make_grid_uniform_rows(G0,equal_row);
+    auto GR = grob::make_grid_uniform_rows(G0,ragged_row);
+    TEST(GU.inner().common_size(),33);
+    TEST(GR.inner().common_size(),0);
+    PVAR(GU.inner(size_t(3)));
+
+    // grid function
+    auto f = [](auto const & P){auto [x,y] = P;return x*x + y;};
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto FU = grob::make_function_f<I2>(GR,f);
+    auto FV = grob::make_function_f<I2>(grob::make_grid_f(G0,ragged_row),f);
+    TEST(FU.Values == FV.Values,true);
+    double max_diff = 0;
+    for(size_t k=2;k<1000;++k){
+        auto [x,y] = X[k];
+        max_diff = std::max(max_diff,std::abs(FU(x,y) - FV(x,y)));
+    }
+    TEST(max_diff,0);
+    return 0;
+}
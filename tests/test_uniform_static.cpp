@@ -0,0 +1,106 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/grid_objects.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+#include <sstream>
+
+struct StreamReader{
+    std::istream & is;
+    template <typename T>
+    void read(T & x){is >> x;}
+};
+struct StreamWriter{
+    std::ostream & os;
+    template <typename T>
+    void write(T const & x){os << x << " ";}
+};
+
+int main(){
+    typedef grob::GridUniformStatic<double,101,std::ratio<-1>,std::ratio<3,2>> GS_t;
+    constexpr GS_t GS{};
+    static_assert(GS_t::h_inv() == 40.0,"h_inv should be constexpr");
+    static_assert(GS[0] == -1.0 && GS[100] == 1.5,"operator[] should be constexpr");
+    static_assert(GS.size() == 101,"size should be constexpr");
+    static_assert(GS.pos(0.0) == 40,"pos should be constexpr");
+    PVAR(GS);
+
+    grob::GridUniform<double> GR(-1.0,1.5,101);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(-1.5,2.0);
+    std::vector<double> X(1 << 20);
+    for(auto & x : X){
+        x = dist(gen);
+    }
+    X[1] = NAN;
+    X[2] = -1.0;
+    X[3] = 1.5;
+
+    size_t errors = 0;
+    for(double x : X){
+        errors += (GS.pos(x) != GR.pos(x)) + (GS.contains(x) != GR.contains(x));
+    }
+    TEST(errors,0);
+    for(size_t i=0;i<GS.size();++i){
+        errors += (GS[i] != GR[i]);
+    }
+    TEST(errors,0);
+
+    std::vector<size_t> out(X.size());
+    GS.pos_batch(X.data(),X.size(),out.data());
+    for(size_t k=0;k<X.size();++k){
+        errors += (out[k] != GS.pos(X[k]));
+    }
+    TEST(errors,0);
+
+    // grid functions
+    auto f = [](double x){return std::sin(x);};
+    auto FS = grob::make_function_f(GS,f);
+    auto FR = grob::make_function_f(GR,f);
+    auto FS_spline = grob::make_function_f<grob::interpolator_spline1D>(GS,f);
+    double max_diff = 0;
+    for(size_t k=0;k<1000;++k){
+        max_diff = std::max(max_diff,std::abs(FS(X[k+10]) - FR(X[k+10])));
+    }
+    TEST(max_diff < 1e-12,true);
+    TEST(std::abs(FS_spline(0.3) - f(0.3)) < 1e-3,true);
+
+    // histogramm
+    auto H = grob::make_histo<double>(grob::GridUniformStaticHisto<double,11>{});
+    size_t inside = 0;
+    for(double x : {0.05,0.15,0.151,0.99,1.0,-0.1,1.1}){
+        inside += H.put(1.0,x);
+    }
+    TEST(inside,5);
+    TEST(H.Values[1],2);
+    TEST(H.Values[9],2);
+
+    // mesh grids
+    auto G2 = grob::mesh_grids(GS,grob::GridUniformStatic<double,11>{});
+    auto F2 = grob::make_function_f<grob::interProd<grob::linear_interpolator,grob::linear_interpolator>>(G2,
+                [](auto const & P){auto [x,y] = P;return x + 2*y;});
+    TEST(std::abs(F2(0.33,0.27) - (0.33 + 2*0.27)) < 1e-12,true);
+
+    // write/read
+    std::stringstream ss;
+    StreamWriter W{ss};
+    GS.write(W);
+    StreamReader R{ss};
+    auto GS_read = grob::UniformStaticContainer<double,101,std::ratio<-1>,std::ratio<3,2>>::read(R);
+    TEST(GS_read.size(),GS.size());
+    std::stringstream bad("0 1 101");
+    StreamReader R_bad{bad};
+    bool thrown = false;
+    try{
+        grob::UniformStaticContainer<double,101,std::ratio<-1>,std::ratio<3,2>>::read(R_bad);
+    }catch(std::range_error const & e){
+        thrown = true;
+        PVAR(e.what());
+    }
+    TEST(thrown,true);
+
+    return 0;
+}
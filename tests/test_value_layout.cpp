@@ -0,0 +1,89 @@
+#include <iostream>
+
+#include "debug_defs.hpp"
+
+#include "../include/grob/value_layout.hpp"
+#include <vector>
+#include <random>
+#include <cmath>
+
+template <typename Layout>
+size_t check_layout(size_t n0,size_t n1,size_t n2){
+    Layout L({n0,n1,n2});
+    std::vector<size_t> used(L.storage_size(),0);
+    size_t errors = 0;
+    for(size_t i=0;i<L.size();++i){
+        auto mi = L.unravel(i);
+        errors += (mi[0]*n1*n2 + mi[1]*n2 + mi[2] != i);
+        errors += (L(i) >= used.size()) || (used[L(i)]++ != 0);
+    }
+    return errors;
+}
+
+int main(){
+    // layouts are injective maps into storage
+    size_t errors = check_layout<grob::morton_layout<3>>(7,13,5);
+    errors += check_layout<grob::tiled_layout<3,4>>(7,13,5);
+    errors += check_layout<grob::row_major_layout<3>>(7,13,5);
+    TEST(errors,0);
+
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0,1);
+    const size_t N = 10000;
+
+    // 2-dim
+    typedef grob::interProd<grob::linear_interpolator,grob::linear_interpolator> I2;
+    auto f2 = [](auto const & P){auto [x,y] = P;return x*x + std::sin(y);};
+    const size_t n2 = 256;
+    auto G2 = grob::mesh_grids(grob::GridUniform<double>(0,1,n2),grob::GridUniform<double>(0,1,n2));
+    auto F2 = grob::make_function_f<I2>(G2,f2);
+    auto F2m = grob::with_layout<grob::morton_layout<2>>(F2);
+    auto F2t = grob::with_layout<grob::tiled_layout<2,8>>(F2);
+    TEST(F2m.Values.Data.size(),n2*n2);
+    std::vector<grob::Point<double,double>> X2(N);
+    for(auto & P : X2){
+        P = grob::make_point(dist(gen),dist(gen));
+    }
+    for(size_t k=0;k<N;++k){
+        auto [x,y] = X2[k];
+        errors += (F2m(x,y) != F2(x,y)) + (F2t(x,y) != F2(x,y));
+    }
+    for(auto [MI,i,X,V] : F2t.enumerate()){
+        errors += (V != F2[MI]) + (F2m[MI] != F2[MI]);
+    }
+    TEST(errors,0);
+
+    // histogram with tiled layout
+    auto H = grob::make_histo<double>(grob::mesh_grids(grob::GridUniformHisto<double>(0,1,101),
+                grob::GridUniformHisto<double>(0,1,51)));
+    auto Ht = grob::with_layout<grob::tiled_layout<2,8>>(H);
+    for(size_t k=0;k<N;++k){
+        auto [x,y] = X2[k];
+        H.put(1.0,x,y);
+        Ht.put(1.0,x,y);
+    }
+    for(auto [MI,i,X,V] : H.enumerate()){
+        errors += (V != Ht[MI]);
+    }
+    TEST(errors,0);
+
+    // 3-dim
+    typedef grob::interProd<grob::linear_interpolator,I2> I3;
+    auto f3 = [](auto const & P){auto [x,y,z] = P;return x*y + z;};
+    const size_t n3 = 41;
+    auto G3 = grob::mesh_grids(grob::GridUniform<double>(0,1,n3),
+        grob::mesh_grids(grob::GridUniform<double>(0,1,n3),grob::GridUniform<double>(0,1,n3)));
+    auto F3 = grob::make_function_f<I3>(G3,f3);
+    auto F3m = grob::with_layout<grob::morton_layout<3>>(F3);
+    auto F3t = grob::with_layout<grob::tiled_layout<3,4>>(F3);
+    std::vector<grob::Point<double,double,double>> X3(N);
+    for(auto & P : X3){
+        P = grob::make_point(dist(gen),dist(gen),dist(gen));
+    }
+    for(size_t k=0;k<N;++k){
+        auto [x,y,z] = X3[k];
+        errors += (F3m(x,y,z) != F3(x,y,z)) + (F3t(x,y,z) != F3(x,y,z));
+    }
+    TEST(errors,0);
+    return 0;
+}